@@ -0,0 +1,45 @@
+// See LICENSE for license details.
+
+#ifndef __GENDATA_H
+#define __GENDATA_H
+
+//--------------------------------------------------------------------------
+// On-target dataset generation
+//
+// Element i of a generated array depends only on its seed and on i, so a
+// benchmark can build its inputs at startup, split across harts in any
+// order, and later regenerate them to compute the digest its results are
+// checked against (see digest_u64() in util.h), unless -DVERIFY_DIGEST
+// supplies it.  The problem size then becomes a -D parameter that costs
+// nothing in the ELF.
+
+#include "util.h"
+
+static inline uint64_t gen_u64(uint64_t seed, size_t i)
+{
+  // splitmix64, evaluated at step i
+  uint64_t z = seed + (i + 1) * 0x9e3779b97f4a7c15ULL;
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31);
+}
+
+// uniform in [0, range), like rand(range) in the gendata scripts
+static inline uint32_t gen_range(uint64_t seed, size_t i, uint32_t range)
+{
+  return ((gen_u64(seed, i) >> 32) * range) >> 32;
+}
+
+static void gen_int(int* a, size_t begin, size_t end, uint64_t seed, uint32_t range)
+{
+  for (size_t i = begin; i < end; i++)
+    a[i] = gen_range(seed, i, range);
+}
+
+static void gen_double(double* a, size_t begin, size_t end, uint64_t seed, uint32_t range)
+{
+  for (size_t i = begin; i < end; i++)
+    a[i] = gen_range(seed, i, range);
+}
+
+#endif //__GENDATA_H
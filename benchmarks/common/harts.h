@@ -0,0 +1,17 @@
+// See LICENSE for license details.
+
+#ifndef __HARTS_H
+#define __HARTS_H
+
+// Harts 0..nc-1 enter thread_entry().  NHARTS fixes nc at build time;
+// otherwise up to MAX_HARTS harts are discovered at boot.  crt.S parks
+// any hart beyond MAX_HARTS, and the C side sizes its per-hart state by
+// it, so both take it from here.  Preprocessor only: this is included
+// from assembly.
+#ifdef NHARTS
+# define MAX_HARTS NHARTS
+#elif !defined(MAX_HARTS)
+# define MAX_HARTS 8
+#endif
+
+#endif //__HARTS_H
@@ -0,0 +1,111 @@
+// See LICENSE for license details.
+
+#ifndef __LOCK_H
+#define __LOCK_H
+
+//--------------------------------------------------------------------------
+// Spinlocks
+//
+// Three locks with the same acquire/release shape: test-and-test-and-set,
+// ticket and MCS.  TTAS is the cheapest uncontended but every waiter
+// hammers the one line on release, and who gets it next is luck.  The
+// ticket lock is FIFO but all waiters still spin on one line.  The MCS
+// lock is FIFO and each waiter spins on its own node, which the caller
+// supplies and must keep until release; one node per hart will do.
+//
+// Acquiring is an acquire operation and releasing a release operation in
+// the RVWMO sense: an AMO that takes the lock carries .aq, one that hands
+// it on carries .rl, and where the lock is taken by a plain load of a
+// value another hart stored, a fence r,rw follows the load.  All locks
+// are zero when free, so static ones need no initialization.
+
+#include "util.h"
+
+typedef struct {
+  volatile uint32_t locked;
+} __attribute__((aligned(CACHE_LINE_SIZE))) ttas_lock_t;
+
+static inline void ttas_acquire(ttas_lock_t* l)
+{
+  for (;;) {
+    // spin in our own cache until the lock looks free
+    while (l->locked)
+      ;
+    uint32_t old;
+    asm volatile ("amoswap.w.aq %0, %2, %1" : "=r"(old), "+A"(l->locked) : "r"(1) : "memory");
+    if (!old)
+      return;
+  }
+}
+
+static inline void ttas_release(ttas_lock_t* l)
+{
+  asm volatile ("amoswap.w.rl zero, zero, %0" : "+A"(l->locked) :: "memory");
+}
+
+typedef struct {
+  volatile uint32_t next;    // next ticket to hand out
+  volatile uint32_t owner;   // ticket now holding the lock
+} __attribute__((aligned(CACHE_LINE_SIZE))) ticket_lock_t;
+
+static inline void ticket_acquire(ticket_lock_t* l)
+{
+  uint32_t t;
+  asm volatile ("amoadd.w %0, %2, %1" : "=r"(t), "+A"(l->next) : "r"(1) : "memory");
+  while (l->owner != t)
+    ;
+  asm volatile ("fence r, rw" ::: "memory");
+}
+
+static inline void ticket_release(ticket_lock_t* l)
+{
+  asm volatile ("amoadd.w.rl zero, %1, %0" : "+A"(l->owner) : "r"(1) : "memory");
+}
+
+typedef struct mcs_node {
+  struct mcs_node* volatile next;
+  volatile uint32_t locked;
+} __attribute__((aligned(CACHE_LINE_SIZE))) mcs_node_t;
+
+typedef struct {
+  mcs_node_t* volatile tail;
+} __attribute__((aligned(CACHE_LINE_SIZE))) mcs_lock_t;
+
+static inline void mcs_acquire(mcs_lock_t* l, mcs_node_t* me)
+{
+  me->next = 0;
+  me->locked = 1;
+  // .rl publishes our node before we join the queue; .aq because with
+  // no one ahead of us the swap takes the lock
+  mcs_node_t* pred;
+  asm volatile ("amoswap" AMO_WIDTH ".aqrl %0, %2, %1" : "=r"(pred), "+A"(l->tail) : "r"(me) : "memory");
+  if (pred) {
+    pred->next = me;
+    while (me->locked)
+      ;
+    asm volatile ("fence r, rw" ::: "memory");
+  }
+}
+
+static inline void mcs_release(mcs_lock_t* l, mcs_node_t* me)
+{
+  if (!me->next) {
+    // no one has queued behind us yet, so try to leave the lock free
+    mcs_node_t* tail;
+    uintptr_t fail;
+    asm volatile ("1: lr" AMO_WIDTH " %0, %2\n"
+                  "   bne %0, %3, 2f\n"
+                  "   sc" AMO_WIDTH ".rl %1, zero, %2\n"
+                  "   bnez %1, 1b\n"
+                  "2:"
+                  : "=&r"(tail), "=&r"(fail), "+A"(l->tail) : "r"(me) : "memory");
+    if (tail == me)
+      return;
+    // someone has swapped themselves in but not yet linked to us
+    while (!me->next)
+      ;
+  }
+  asm volatile ("amoswap.w.rl zero, zero, %0" : "+A"(me->next->locked) :: "memory");
+}
+
+#endif //__LOCK_H
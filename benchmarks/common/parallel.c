@@ -0,0 +1,214 @@
+// See LICENSE for license details.
+
+#include <stdint.h>
+#include "util.h"
+#include "parallel.h"
+
+static barrier_global_data_t parallel_bar;
+static __thread barrier_local_data_t parallel_lbar;
+// Dynamic loops alternate between two counters.  One loop's counter is
+// reset during the next, after the barrier ending its loop.
+static struct {
+  volatile size_t next;
+} __attribute__((aligned(CACHE_LINE_SIZE))) parallel_chunk[2];
+static __thread int parallel_parity;
+
+void parallel_init(int nc)
+{
+  parallel_lbar = (barrier_local_data_t){nc};
+}
+
+void parallel_for_sched(sched_t sched, size_t begin, size_t end, size_t grain,
+                        parallel_fn_t fn, void* arg)
+{
+  int cid = read_csr(mhartid), nc = parallel_lbar.ncores;
+  size_t n = end > begin ? end - begin : 0;
+  grain = grain ? grain : 1;
+  size_t chunks = (n + grain - 1) / grain;
+
+#define CHUNK(j, k) fn(begin + (j)*grain, (k) < chunks ? begin + (k)*grain : end, arg)
+
+  switch (sched) {
+    case SCHED_STATIC: {
+      size_t j = chunks*cid/nc, k = chunks*(cid+1)/nc;
+      if (j < k)
+        CHUNK(j, k);
+      break;
+    }
+    case SCHED_CHUNKED:
+      for (size_t j = cid; j < chunks; j += nc)
+        CHUNK(j, j+1);
+      break;
+    case SCHED_DYNAMIC: {
+      int p = parallel_parity;
+      parallel_parity = !p;
+      if (cid == 0)
+        parallel_chunk[!p].next = 0;
+      for (size_t j; (j = atomic_fetch_add_explicit(&parallel_chunk[p].next, 1, memory_order_relaxed)) < chunks; )
+        CHUNK(j, j+1);
+      break;
+    }
+  }
+
+#undef CHUNK
+
+  if (nc > 1)
+    barrier(&parallel_bar, &parallel_lbar);
+}
+
+//--------------------------------------------------------------------------
+// Tasks
+
+#ifndef TASK_DEQUE_SIZE
+# define TASK_DEQUE_SIZE 256
+#endif
+
+typedef struct {
+  volatile long top;
+  // the owner's end gets its own line, which thieves only read
+  volatile long bottom __attribute__((aligned(CACHE_LINE_SIZE)));
+  task_t* volatile buf[TASK_DEQUE_SIZE];
+} __attribute__((aligned(CACHE_LINE_SIZE))) task_deque_t;
+
+static task_deque_t task_deque[MAX_HARTS];
+
+static volatile int task_epoch;
+static __thread int task_my_epoch, task_victim;
+static __thread size_t task_nsteals;
+
+static inline void task_fence()
+{
+  asm volatile ("fence rw, rw" ::: "memory");
+}
+
+static inline int task_cas(volatile long* p, long old, long new)
+{
+  long v;
+  uintptr_t fail;
+  asm volatile ("1: lr" AMO_WIDTH ".aqrl %0, %2\n"
+                "   bne %0, %3, 2f\n"
+                "   sc" AMO_WIDTH ".rl %1, %4, %2\n"
+                "   bnez %1, 1b\n"
+                "2:"
+                : "=&r"(v), "=&r"(fail), "+A"(*p) : "r"(old), "r"(new) : "memory");
+  return v == old;
+}
+
+static int task_push(task_t* t)
+{
+  task_deque_t* d = &task_deque[read_csr(mhartid)];
+  long b = d->bottom;
+  if (b - d->top >= TASK_DEQUE_SIZE)
+    return 0;
+  d->buf[b % TASK_DEQUE_SIZE] = t;
+  asm volatile ("fence rw, w" ::: "memory");
+  d->bottom = b + 1;
+  return 1;
+}
+
+static task_t* task_pop()
+{
+  task_deque_t* d = &task_deque[read_csr(mhartid)];
+  long b = d->bottom - 1;
+  d->bottom = b;
+  // thieves must see the slot as taken before we look at top
+  task_fence();
+  long t = d->top;
+  if (t > b) {
+    d->bottom = b + 1;
+    return NULL;
+  }
+  task_t* task = d->buf[b % TASK_DEQUE_SIZE];
+  if (t == b) {
+    // the last task: race any thief for it
+    if (!task_cas(&d->top, t, t + 1))
+      task = NULL;
+    d->bottom = b + 1;
+  }
+  return task;
+}
+
+static task_t* task_steal(int victim)
+{
+  task_deque_t* d = &task_deque[victim];
+  long t = d->top;
+  task_fence();
+  long b = d->bottom;
+  if (t >= b)
+    return NULL;
+  // the slot must not be read before the bottom that says it is filled
+  asm volatile ("fence r, r" ::: "memory");
+  task_t* task = d->buf[t % TASK_DEQUE_SIZE];
+  if (!task_cas(&d->top, t, t + 1))
+    return NULL;
+  return task;
+}
+
+static void task_exec(task_t* t)
+{
+  t->fn(t->arg);
+  asm volatile ("fence rw, w" ::: "memory");
+  t->done = 1;
+}
+
+// Try the next other hart's deque, and run what we get
+static void task_try_steal()
+{
+  int cid = read_csr(mhartid), nc = parallel_lbar.ncores;
+  if (nc == 1)
+    return;
+  task_victim = (task_victim + 1) % nc;
+  if (task_victim == cid)
+    task_victim = (task_victim + 1) % nc;
+  task_t* t = task_steal(task_victim);
+  if (t) {
+    task_nsteals++;
+    task_exec(t);
+  }
+}
+
+void task_spawn(task_t* t, void (*fn)(void*), void* arg)
+{
+  t->fn = fn;
+  t->arg = arg;
+  t->done = 0;
+  if (!task_push(t))
+    task_exec(t);
+}
+
+void task_sync(task_t* t)
+{
+  if (!t->done) {
+    // with syncs nested, the bottom task is t unless t was stolen
+    task_t* s = task_pop();
+    if (s)
+      task_exec(s);
+    while (!t->done)
+      task_try_steal();
+  }
+  asm volatile ("fence r, rw" ::: "memory");
+}
+
+void task_run(void (*fn)(void*), void* arg)
+{
+  int cid = read_csr(mhartid), nc = parallel_lbar.ncores;
+  int epoch = ++task_my_epoch;
+
+  task_nsteals = 0;
+  if (cid == 0) {
+    fn(arg);
+    asm volatile ("fence rw, w" ::: "memory");
+    task_epoch = epoch;
+  } else {
+    while (task_epoch != epoch)
+      task_try_steal();
+  }
+
+  if (nc > 1)
+    barrier(&parallel_bar, &parallel_lbar);
+}
+
+size_t task_steals()
+{
+  return task_nsteals;
+}
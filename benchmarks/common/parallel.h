@@ -0,0 +1,78 @@
+// See LICENSE for license details.
+
+#ifndef __PARALLEL_H
+#define __PARALLEL_H
+
+//--------------------------------------------------------------------------
+// Fork-join loops
+//
+// parallel_for(begin, end, grain, fn, arg) splits [begin, end) into
+// chunks of grain iterations (the last one may be short) and calls
+// fn(lo, hi, arg) on every chunk, spread over the harts.  It is a
+// collective call: every hart that entered thread_entry() makes it with
+// the same arguments, and it returns on each once all of the loop is
+// done.  From main() the one hart runs the whole loop.
+//
+// The schedule decides which hart gets which chunks:
+//
+//   SCHED_STATIC   hart i gets the i'th of nc contiguous runs of chunks,
+//                  in one call to fn
+//   SCHED_CHUNKED  chunk j goes to hart j % nc
+//   SCHED_DYNAMIC  harts take the next chunk from a shared counter as
+//                  they finish the last one
+//
+// parallel_for() uses PARALLEL_SCHEDULE, static unless overridden with
+// -DPARALLEL_SCHEDULE=...; parallel_for_sched() takes it as an argument.
+
+#include <stddef.h>
+
+typedef enum {
+  SCHED_STATIC,
+  SCHED_CHUNKED,
+  SCHED_DYNAMIC,
+} sched_t;
+
+typedef void (*parallel_fn_t)(size_t lo, size_t hi, void* arg);
+
+extern void parallel_init(int nc);
+extern void parallel_for_sched(sched_t sched, size_t begin, size_t end, size_t grain,
+                               parallel_fn_t fn, void* arg);
+
+#ifndef PARALLEL_SCHEDULE
+# define PARALLEL_SCHEDULE SCHED_STATIC
+#endif
+
+static inline void parallel_for(size_t begin, size_t end, size_t grain,
+                                parallel_fn_t fn, void* arg)
+{
+  parallel_for_sched(PARALLEL_SCHEDULE, begin, end, grain, fn, arg);
+}
+
+//--------------------------------------------------------------------------
+// Tasks
+//
+// task_run(fn, arg) is a collective call too.  Hart 0 runs fn(arg) while
+// the others steal work from it, and it returns on each hart once fn has
+// returned.  Inside, task_spawn(t, fn, arg) makes fn(arg) available to
+// other harts, and task_sync(t) returns once it has run, running it here
+// if no one has stolen it.  Syncs must come in the reverse order of their
+// spawns, and t must stay live (e.g. in the spawner's frame) until then.
+// While a hart waits on a stolen task it steals others.
+//
+// Each hart has a Chase-Lev deque of spawned tasks: the owner pushes and
+// pops at the bottom, and thieves take the oldest task from the top.
+// Spawning on a full deque runs the task at once.
+
+typedef struct {
+  void (*fn)(void*);
+  void* arg;
+  volatile int done;
+} task_t;
+
+extern void task_run(void (*fn)(void*), void* arg);
+extern void task_spawn(task_t* t, void (*fn)(void*), void* arg);
+extern void task_sync(task_t* t);
+// tasks this hart stole during the last task_run()
+extern size_t task_steals();
+
+#endif //__PARALLEL_H
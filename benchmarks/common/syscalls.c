@@ -7,16 +7,32 @@
 #include <limits.h>
 #include <sys/signal.h>
 #include "util.h"
+#include "parallel.h"
 
 #define SYS_write 64
 #define HTIF_DEV_CONSOLE 1
-#define HTIF_CONSOLE_CMD_PUTC 1
+#define CONSOLE_BUF_SIZE 128
 
 #undef strcmp
 
 volatile uint64_t tohost __attribute__ ((section (".tohost")));
 volatile uint64_t fromhost __attribute__ ((section (".tohost")));
 
+// tohost/fromhost are shared by all harts, so only one request may be
+// in flight at a time.
+static volatile int htif_lock;
+
+static void htif_acquire()
+{
+  while (atomic_exchange_explicit(&htif_lock, 1, memory_order_acquire))
+    ;
+}
+
+static void htif_release()
+{
+  atomic_store_explicit(&htif_lock, 0, memory_order_release);
+}
+
 static uintptr_t syscall(uintptr_t which, uint64_t arg0, uint64_t arg1, uint64_t arg2)
 {
   volatile uint64_t magic_mem[8] __attribute__((aligned(64)));
@@ -26,37 +42,243 @@ static uintptr_t syscall(uintptr_t which, uint64_t arg0, uint64_t arg1, uint64_t
   magic_mem[3] = arg2;
   __sync_synchronize();
 
+  htif_acquire();
   tohost = (uintptr_t)magic_mem;
   while (fromhost == 0)
     ;
   fromhost = 0;
+  htif_release();
 
   __sync_synchronize();
   return magic_mem[0];
 }
 
-#define NUM_COUNTERS 2
-static uintptr_t counters[NUM_COUNTERS];
-static char* counter_names[NUM_COUNTERS];
+// Hardware performance monitors to sample alongside mcycle and minstret,
+// given at build time as a list of HPM_EVENT(name, selector) entries, e.g.
+//   -DHPM_EVENTS='HPM_EVENT(dcache_miss, 0x202) HPM_EVENT(br_miss, 0x4001)'
+// The n-th entry programs mhpmevent(3+n) and is reported under its name.
+#ifndef HPM_EVENTS
+# define HPM_EVENTS
+#endif
+
+enum {
+#define HPM_EVENT(name, event) hpm_##name,
+  HPM_EVENTS
+#undef HPM_EVENT
+  NUM_HPM_COUNTERS
+};
+
+#define HPM_CSRS(X) \
+  X(3)  X(4)  X(5)  X(6)  X(7)  X(8)  X(9)  X(10) X(11) X(12) \
+  X(13) X(14) X(15) X(16) X(17) X(18) X(19) X(20) X(21) X(22) \
+  X(23) X(24) X(25) X(26) X(27) X(28) X(29) X(30) X(31)
+
+static uintptr_t read_hpmcounter(int n)
+{
+  switch (n) {
+#define X(n) case n: return read_csr(mhpmcounter##n);
+    HPM_CSRS(X)
+#undef X
+  }
+  return 0;
+}
+
+static void write_hpmevent(int n, uintptr_t event)
+{
+  switch (n) {
+#define X(n) case n: write_csr(mhpmevent##n, event); break;
+    HPM_CSRS(X)
+#undef X
+  }
+}
+
+static void init_hpm()
+{
+  static_assert(NUM_HPM_COUNTERS <= 29);
+
+#define HPM_EVENT(name, event) write_hpmevent(3 + hpm_##name, event);
+  HPM_EVENTS
+#undef HPM_EVENT
+
+  if (NUM_HPM_COUNTERS)
+    clear_csr(mcountinhibit, (((uintptr_t)1 << NUM_HPM_COUNTERS) - 1) << 3);
+}
+
+#define NUM_COUNTERS (2 + NUM_HPM_COUNTERS)
+static const char* counter_names[NUM_COUNTERS];
+
+// Each hart records its own counters, on a cache line of its own.
+static struct {
+  uintptr_t counters[NUM_COUNTERS];
+} __attribute__((aligned(CACHE_LINE_SIZE))) hart_stats[MAX_HARTS];
+
+static barrier_global_data_t stats_bar;
+static __thread barrier_local_data_t stats_lbar;
+static unsigned long stats_size;
+
+void setStatsSize(unsigned long size)
+{
+  stats_size = size;
+}
 
 void setStats(int enable)
 {
+  uintptr_t* counters = hart_stats[read_csr(mhartid)].counters;
   int i = 0;
-#define READ_CTR(name) do { \
+
+  if (!enable)
+    roi_end();
+
+#define READ_CTR(name, value) do { \
     while (i >= NUM_COUNTERS) ; \
-    uintptr_t csr = read_csr(name); \
-    if (!enable) { csr -= counters[i]; counter_names[i] = #name; } \
+    uintptr_t csr = (value); \
+    if (!enable) { csr -= counters[i]; counter_names[i] = name; } \
     counters[i++] = csr; \
   } while (0)
 
-  READ_CTR(mcycle);
-  READ_CTR(minstret);
+  READ_CTR("mcycle", read_csr(mcycle));
+  READ_CTR("minstret", read_csr(minstret));
+
+#define HPM_EVENT(name, event) READ_CTR(#name, read_hpmcounter(3 + hpm_##name));
+  HPM_EVENTS
+#undef HPM_EVENT
 
 #undef READ_CTR
+
+  if (enable)
+    roi_begin();
+}
+
+void reportStats(const char* code, unsigned long iter)
+{
+  int cid = read_csr(mhartid), nc = stats_lbar.ncores;
+
+  barrier(&stats_bar, &stats_lbar);
+
+  if (cid == 0) {
+    stats_size = iter;
+
+    uintptr_t c = 0, csum = 0, isum = 0;
+    for (int h = 0; h < nc; h++) {
+      uintptr_t hc = hart_stats[h].counters[0];
+      c = hc > c ? hc : c;
+      csum += hc;
+      isum += hart_stats[h].counters[1];
+    }
+    printf("\n%s: %ld cycles, %ld.%ld cycles/iter, %ld.%ld CPI\n",
+           code, c, c/iter, 10*c/iter%10, csum/isum, 10*csum/isum%10);
+
+    for (int i = 0; nc > 1 && i < NUM_COUNTERS; i++) {
+      int hmin = 0, hmax = 0;
+      uintptr_t sum = 0, mean;
+      for (int h = 0; h < nc; h++) {
+        uintptr_t v = hart_stats[h].counters[i];
+        if (v < hart_stats[hmin].counters[i]) hmin = h;
+        if (v > hart_stats[hmax].counters[i]) hmax = h;
+        sum += v;
+      }
+      if ((mean = sum / nc) == 0)
+        continue;
+      // imbalance is how far the slowest hart lags the mean, in permille
+      uintptr_t imb = 1000 * hart_stats[hmax].counters[i] / mean - 1000;
+      printf("  %s: min %lu (C%d), max %lu (C%d), mean %lu, imbalance %lu.%lu%%\n",
+             counter_names[i], hart_stats[hmin].counters[i], hmin,
+             hart_stats[hmax].counters[i], hmax, mean, imb/10, imb%10);
+    }
+  }
+
+  // don't let anyone overwrite their counters before hart 0 has read them
+  barrier(&stats_bar, &stats_lbar);
+}
+
+// The timing harness keeps every counter of every timed run, per hart.
+static struct {
+  uintptr_t counters[BENCH_REPS][NUM_COUNTERS];
+} __attribute__((aligned(CACHE_LINE_SIZE))) bench_samples[MAX_HARTS];
+
+void benchSample(int rep)
+{
+  int cid = read_csr(mhartid);
+  memcpy(bench_samples[cid].counters[rep], hart_stats[cid].counters,
+         sizeof(hart_stats[cid].counters));
+}
+
+unsigned long benchReport(const char* code, unsigned long iter)
+{
+  static_assert(BENCH_REPS > 0);
+  int cid = read_csr(mhartid);
+  uintptr_t* median = hart_stats[cid].counters;
+  iter = iter ? iter : 1;
+
+  for (int i = 0; i < NUM_COUNTERS; i++) {
+    uintptr_t v[BENCH_REPS];
+    for (int r = 0; r < BENCH_REPS; r++) {
+      uintptr_t x = bench_samples[cid].counters[r][i];
+      int j;
+      for (j = r; j > 0 && v[j-1] > x; j--)
+        v[j] = v[j-1];
+      v[j] = x;
+    }
+    median[i] = v[BENCH_REPS/2];
+
+    if (i == 0)
+      printf("\nC%d: %s: %d runs, %s min %lu, median %lu, max %lu, %lu.%lu cycles/iter\n",
+             cid, code, BENCH_REPS, counter_names[i], v[0], median[i],
+             v[BENCH_REPS-1], median[i]/iter, 10*median[i]/iter%10);
+    else
+      printf("C%d:   %s: min %lu, median %lu, max %lu\n",
+             cid, counter_names[i], v[0], median[i], v[BENCH_REPS-1]);
+  }
+
+  stats_size = iter;
+  return median[0];
+}
+
+// Write back and invalidate the lines holding [addr, addr+bytes).  With
+// Zicbom that is a cbo.flush per line; otherwise, when built with
+// -DCACHE_EVICT_SIZE=bytes (at least the last-level cache size), reading
+// a buffer that large evicts everything instead.  Without either this
+// does nothing.
+#if !defined(__riscv_zicbom) && defined(CACHE_EVICT_SIZE)
+static volatile char evict_buf[CACHE_EVICT_SIZE] __attribute__((aligned(CACHE_LINE_SIZE)));
+#endif
+
+void flushCaches(const volatile void* addr, size_t bytes)
+{
+#if defined(__riscv_zicbom)
+  uintptr_t p = (uintptr_t)addr & -CACHE_LINE_SIZE;
+  for ( ; p < (uintptr_t)addr + bytes; p += CACHE_LINE_SIZE)
+    asm volatile ("cbo.flush 0(%0)" :: "r"(p) : "memory");
+  asm volatile ("fence" ::: "memory");
+#elif defined(CACHE_EVICT_SIZE)
+  for (size_t i = 0; i < CACHE_EVICT_SIZE; i += CACHE_LINE_SIZE)
+    evict_buf[i];
+#endif
+}
+
+// Console output is collected per hart and handed to the host a line at
+// a time, rather than paying for an HTIF round trip on every character.
+static __thread char console_buf[CONSOLE_BUF_SIZE];
+static __thread size_t console_len;
+
+static void console_flush()
+{
+  if (console_len) {
+    syscall(SYS_write, HTIF_DEV_CONSOLE, (uintptr_t)console_buf, console_len);
+    console_len = 0;
+  }
+}
+
+static void console_putc(char c)
+{
+  console_buf[console_len++] = c;
+  if (c == '\n' || console_len == CONSOLE_BUF_SIZE)
+    console_flush();
 }
 
 void __attribute__((noreturn)) tohost_exit(uintptr_t code)
 {
+  htif_acquire();
   tohost = (code << 1) | 1;
   while (1);
 }
@@ -66,8 +288,39 @@ uintptr_t __attribute__((weak)) handle_trap(uintptr_t cause, uintptr_t epc, uint
   tohost_exit(1337);
 }
 
+#ifndef BENCHMARK_NAME
+# define BENCHMARK_NAME "unknown"
+#endif
+
+// At exit, each hart's last measured region goes out as one line of JSON,
+// for the report target to collect into a table.
+static void print_records(int code)
+{
+  for (int h = 0; h < stats_lbar.ncores; h++) {
+    printf("{\"benchmark\": \"%s\", \"hart\": %d, \"harts\": %d, \"size\": %lu, "
+           "\"verify\": \"%s\", \"exit_code\": %d",
+           BENCHMARK_NAME, h, stats_lbar.ncores, stats_size,
+           code ? "fail" : "pass", code);
+    for (int i = 0; i < NUM_COUNTERS; i++)
+      if (counter_names[i])
+        printf(", \"%s\": %lu", counter_names[i], hart_stats[h].counters[i]);
+    printf("}\n");
+  }
+}
+
+// The first hart to exit reports for all of them and its code is the one
+// the host sees; any hart that exits after it only flushes its console
+// and parks, so the records go out once and carry that verdict.
+static volatile int exiting;
+
 void exit(int code)
 {
+  if (atomic_exchange_explicit(&exiting, 1, memory_order_relaxed)) {
+    console_flush();
+    while (1);
+  }
+  print_records(code);
+  console_flush();
   tohost_exit(code);
 }
 
@@ -78,16 +331,16 @@ void abort()
 
 void printstr(const char* s)
 {
-  while (*s) {
-    syscall(SYS_write, HTIF_DEV_CONSOLE, (uintptr_t)s++, HTIF_CONSOLE_CMD_PUTC);
-  }
+  while (*s)
+    console_putc(*s++);
 }
 
 void __attribute__((weak)) thread_entry(int cid, int nc)
 {
   // multi-threaded programs override this function.
   // for the case of single-threaded programs, only let core 0 proceed.
-  while (cid != 0);
+  while (cid != 0)
+    hart_sleep();
 }
 
 int __attribute__((weak)) main(int argc, char** argv)
@@ -107,14 +360,113 @@ static void init_tls()
   memset(thread_pointer + tdata_size, 0, tbss_size);
 }
 
+// The heap is split evenly across the harts that were found at boot;
+// single-threaded programs get all of it.
+static __thread uintptr_t arena_begin, arena_cur, arena_end;
+
+static void init_arena(int cid, int nc)
+{
+  extern char _heap_start, _heap_end;
+  uintptr_t size = (uintptr_t)(&_heap_end - &_heap_start) / nc & -CACHE_LINE_SIZE;
+  arena_begin = arena_cur = (uintptr_t)&_heap_start + cid * size;
+  arena_end = arena_begin + size;
+}
+
+void* arena_alloc(size_t size, size_t align)
+{
+  uintptr_t p = (arena_cur + align - 1) & -align;
+  if (p < arena_cur || p > arena_end || size > arena_end - p) {
+    printf("C%d: arena_alloc(%lu) out of memory\n", (int)read_csr(mhartid), size);
+    abort();
+  }
+  arena_cur = p + size;
+  return (void*)p;
+}
+
+void* arena_mark()
+{
+  return (void*)arena_cur;
+}
+
+void arena_release(void* mark)
+{
+  arena_cur = (uintptr_t)mark;
+}
+
+void arena_reset()
+{
+  arena_cur = arena_begin;
+}
+
+#ifdef NHARTS
+static int boot_harts(int cid, int nc)
+{
+  return nc;
+}
+#else
+// Each hart sets its bit in boot_mask on arrival.  Hart 0 waits until all
+// max_harts harts have checked in, or until HART_BOOT_TIMEOUT cycles have
+// passed, and then publishes the number of harts with contiguous IDs from
+// 0.  Any other hart that showed up is parked.  Slow targets (RTL
+// simulation, FPGAs) may need a longer -DHART_BOOT_TIMEOUT, and hart 0
+// says how many harts it found whenever that is fewer than max_harts.
+#ifndef HART_BOOT_TIMEOUT
+# define HART_BOOT_TIMEOUT 1000000
+#endif
+
+static volatile uintptr_t boot_mask;
+static volatile int boot_nharts;
+
+static int boot_harts(int cid, int max_harts)
+{
+  int nc;
+
+  atomic_fetch_or_explicit(&boot_mask, (uintptr_t)1 << cid, memory_order_relaxed);
+
+  if (cid == 0) {
+    uintptr_t all = ((uintptr_t)2 << (max_harts - 1)) - 1;
+    uintptr_t mask, start = read_csr(mcycle);
+    do
+      mask = atomic_load_explicit(&boot_mask, memory_order_relaxed);
+    while (mask != all && read_csr(mcycle) - start < HART_BOOT_TIMEOUT);
+
+    nc = mask == all ? max_harts : __builtin_ctzl(~mask);
+    atomic_store_explicit(&boot_nharts, nc, memory_order_release);
+    hart_wake_others(nc);
+    if (nc < max_harts)
+      printf("%d of up to %d harts checked in within %d cycles\n",
+             nc, max_harts, HART_BOOT_TIMEOUT);
+    return nc;
+  }
+
+  while ((nc = atomic_load_explicit(&boot_nharts, memory_order_acquire)) == 0)
+    hart_sleep();
+  while (cid >= nc)
+    hart_sleep();
+  return nc;
+}
+#endif
+
 void _init(int cid, int nc)
 {
   init_tls();
+  init_hpm();
+#ifdef WFI_WAIT
+  set_csr(mie, MIP_MSIP);
+#endif
+  nc = boot_harts(cid, nc);
+  stats_lbar.ncores = nc;
+  init_arena(cid, nc);
+  parallel_init(nc);
   thread_entry(cid, nc);
 
   // only single-threaded programs should ever get here.
+  stats_lbar.ncores = 1;
+  init_arena(cid, 1);
+  parallel_init(1);
   int ret = main(0, 0);
 
+  uintptr_t* counters = hart_stats[cid].counters;
   char buf[NUM_COUNTERS * 32] __attribute__((aligned(64)));
   char* pbuf = buf;
   for (int i = 0; i < NUM_COUNTERS; i++)
@@ -129,9 +481,7 @@ void _init(int cid, int nc)
 #undef putchar
 int putchar(int ch)
 {
-  char c = ch;
-
-  syscall(SYS_write, HTIF_DEV_CONSOLE, (uintptr_t)&c, HTIF_CONSOLE_CMD_PUTC);
+  console_putc(ch);
 
   return 0;
 }
@@ -373,7 +723,7 @@ int sprintf(char* str, const char* fmt, ...)
   return str - str0;
 }
 
-void* memcpy(void* dest, const void* src, size_t len)
+void* memcpy_scalar(void* dest, const void* src, size_t len)
 {
   if ((((uintptr_t)dest | (uintptr_t)src | len) & (sizeof(uintptr_t)-1)) == 0) {
     const uintptr_t* s = src;
@@ -403,7 +753,7 @@ void* memcpy(void* dest, const void* src, size_t len)
   return dest;
 }
 
-void* memset(void* dest, int byte, size_t len)
+void* memset_scalar(void* dest, int byte, size_t len)
 {
   if ((((uintptr_t)dest | len) & (sizeof(uintptr_t)-1)) == 0) {
     uintptr_t word = byte & 0xFF;
@@ -422,7 +772,7 @@ void* memset(void* dest, int byte, size_t len)
   return dest;
 }
 
-size_t strlen(const char *s)
+size_t strlen_scalar(const char *s)
 {
   const char *p = s;
   while (*p)
@@ -438,7 +788,7 @@ size_t strnlen(const char *s, size_t n)
   return p - s;
 }
 
-int strcmp(const char* s1, const char* s2)
+int strcmp_scalar(const char* s1, const char* s2)
 {
   unsigned char c1, c2;
 
@@ -450,6 +800,39 @@ int strcmp(const char* s1, const char* s2)
   return c1 - c2;
 }
 
+// On vector-capable cores these use the RVV versions in vec-string.S,
+// unless built with -DSCALAR_STRING.  The scalar versions above stay
+// callable either way, so benchmarks can compare the two.
+#if defined(__riscv_vector) && !defined(SCALAR_STRING)
+void* memcpy_vec(void* dest, const void* src, size_t len);
+void* memset_vec(void* dest, int byte, size_t len);
+size_t strlen_vec(const char *s);
+int strcmp_vec(const char* s1, const char* s2);
+# define STRING_IMPL(name) name##_vec
+#else
+# define STRING_IMPL(name) name##_scalar
+#endif
+
+void* memcpy(void* dest, const void* src, size_t len)
+{
+  return STRING_IMPL(memcpy)(dest, src, len);
+}
+
+void* memset(void* dest, int byte, size_t len)
+{
+  return STRING_IMPL(memset)(dest, byte, len);
+}
+
+size_t strlen(const char *s)
+{
+  return STRING_IMPL(strlen)(s);
+}
+
+int strcmp(const char* s1, const char* s2)
+{
+  return STRING_IMPL(strcmp)(s1, s2);
+}
+
 char* strcpy(char* dest, const char* src)
 {
   char* d = dest;
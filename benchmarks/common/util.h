@@ -4,12 +4,57 @@
 #define __UTIL_H
 
 extern void setStats(int enable);
+extern void reportStats(const char* code, unsigned long iter);
+// The problem size recorded with the results; reportStats() sets it too.
+extern void setStatsSize(unsigned long size);
+extern void benchSample(int rep);
+extern unsigned long benchReport(const char* code, unsigned long iter);
+
+#include <stddef.h>
+
+extern void flushCaches(const volatile void* addr, size_t bytes);
+
+// Each hart allocates from its own arena, a slice of the heap between the
+// program's data and the stacks.  align must be a power of two.  Running
+// out of space aborts.
+// arena_release() frees everything allocated since the matching
+// arena_mark(); arena_reset() frees everything.
+extern void* arena_alloc(size_t size, size_t align);
+extern void* arena_mark();
+extern void arena_release(void* mark);
+extern void arena_reset();
+
+// Scalar string routines, for comparison with the default ones
+extern void* memcpy_scalar(void* dest, const void* src, size_t len);
+extern void* memset_scalar(void* dest, int byte, size_t len);
+extern size_t strlen_scalar(const char *s);
+extern int strcmp_scalar(const char* s1, const char* s2);
 
 #include <stdint.h>
 #include <stdatomic.h>
 
 #define static_assert(cond) switch(0) { case 0: case !!(long)(cond): ; }
 
+#include "harts.h"
+
+#ifndef CACHE_LINE_SIZE
+# define CACHE_LINE_SIZE 64
+#endif
+
+// Width suffix of AMOs and LR/SC on XLEN-sized data (longs, pointers),
+// for inline asm, e.g. "amoadd" AMO_WIDTH " %0, %2, %1"
+#if __riscv_xlen == 64
+# define AMO_WIDTH ".d"
+#else
+# define AMO_WIDTH ".w"
+#endif
+
+// Data marked FASTMEM is linked into .fastmem, which test.ld places in a
+// scratchpad or TCM when linked with -Wl,--defsym=__fastmem_base=addr,
+// and in RAM otherwise.  Zero-initialized data there takes space in the
+// ELF, since the loader has to write it.
+#define FASTMEM __attribute__((section(".fastmem")))
+
 static int verify(int n, const volatile int* test, const int* verify)
 {
   int i;
@@ -58,17 +103,186 @@ static int verifyFloat(int n, const volatile float* test, const float* verify)
   return 0;
 }
 
+// Result digests: a CRC-64 (ECMA-182 polynomial, MSB first, initial value
+// all ones) over a stream of 64-bit words, one word per element.  Checking
+// results against a single expected digest means the reference output
+// need not be stored or streamed through the caches.  Elements are
+// compared bitwise, so unlike verifyDouble() 0.0 and -0.0 differ.
+#define DIGEST_INIT (~0ULL)
+#define DIGEST_POLY 0x42f0e1eba9ea3693ULL
+#define DIGEST_MU   0x578d29d06cc4f872ULL // floor(x^128 / P) - x^64
+
+static inline uint64_t digest_u64(uint64_t crc, uint64_t word)
+{
+  uint64_t a = crc ^ word;
+#if (defined(__riscv_zbc) || defined(__riscv_zbkc)) && __riscv_xlen == 64
+  // Barrett reduction of a * x^64 mod P: q = a * x^128/P / x^64, then
+  // the remainder is the low half of q * P.
+  uint64_t q, r;
+  asm ("clmulh %0, %1, %2" : "=r"(q) : "r"(a), "r"(DIGEST_MU));
+  q ^= a;
+  asm ("clmul %0, %1, %2" : "=r"(r) : "r"(q), "r"(DIGEST_POLY));
+  return r;
+#else
+  // (n * x^64) mod P for each top nibble n
+  static const uint64_t table[16] = {
+    0x0000000000000000ULL, 0x42f0e1eba9ea3693ULL, 0x85e1c3d753d46d26ULL, 0xc711223cfa3e5bb5ULL,
+    0x493366450e42ecdfULL, 0x0bc387aea7a8da4cULL, 0xccd2a5925d9681f9ULL, 0x8e224479f47cb76aULL,
+    0x9266cc8a1c85d9beULL, 0xd0962d61b56fef2dULL, 0x17870f5d4f51b498ULL, 0x5577eeb6e6bb820bULL,
+    0xdb55aacf12c73561ULL, 0x99a54b24bb2d03f2ULL, 0x5eb4691841135847ULL, 0x1c4488f3e8f96ed4ULL,
+  };
+  for (int i = 0; i < 16; i++)
+    a = (a << 4) ^ table[a >> 60];
+  return a;
+#endif
+}
+
+static inline uint64_t digest_double1(uint64_t crc, double v)
+{
+  union { double d; uint64_t u; } x = { v };
+  return digest_u64(crc, x.u);
+}
+
+static inline uint64_t digest_float1(uint64_t crc, float v)
+{
+  union { float f; uint32_t u; } x = { v };
+  return digest_u64(crc, x.u);
+}
+
+static uint64_t digest_int(const volatile int* a, size_t n)
+{
+  uint64_t crc = DIGEST_INIT;
+  for (size_t i = 0; i < n; i++)
+    crc = digest_u64(crc, (uint32_t)a[i]);
+  return crc;
+}
+
+static uint64_t digest_double(const volatile double* a, size_t n)
+{
+  uint64_t crc = DIGEST_INIT;
+  for (size_t i = 0; i < n; i++)
+    crc = digest_double1(crc, a[i]);
+  return crc;
+}
+
+static uint64_t digest_float(const volatile float* a, size_t n)
+{
+  uint64_t crc = DIGEST_INIT;
+  for (size_t i = 0; i < n; i++)
+    crc = digest_float1(crc, a[i]);
+  return crc;
+}
+
+static int verifyDigest(int n, const volatile int* test, uint64_t digest)
+{
+  return digest_int(test, n) != digest;
+}
+
+static int verifyDoubleDigest(int n, const volatile double* test, uint64_t digest)
+{
+  return digest_double(test, n) != digest;
+}
+
+static int verifyFloatDigest(int n, const volatile float* test, uint64_t digest)
+{
+  return digest_float(test, n) != digest;
+}
+
+#ifdef __riscv
+#include "encoding.h"
+#endif
+
+// Region-of-interest markers around every measured region, for tracers,
+// commit logs and samplers to start and stop on.  By default they are
+// the hint nops "slti x0, x0, 1" (begin) and "slti x0, x0, 2" (end),
+// which the ISA reserves for custom use and which any core executes as
+// nops.  With -DROI_CSR=n they are instead writes of 1 and 0 to CSR n,
+// for simulators that watch a custom CSR.
+#define ROI_BEGIN 1
+#define ROI_END 2
+
+static inline void roi_mark(int which)
+{
+#ifdef ROI_CSR
+  asm volatile ("csrw %0, %1" :: "i"(ROI_CSR), "r"(which == ROI_BEGIN) : "memory");
+#else
+  asm volatile ("slti x0, x0, %0" :: "i"(which) : "memory");
+#endif
+}
+
+static inline void roi_begin() { roi_mark(ROI_BEGIN); }
+static inline void roi_end() { roi_mark(ROI_END); }
+
+// With -DWFI_WAIT, harts with nothing to do sleep in wfi rather than
+// spin, and whoever releases them sends a software interrupt through the
+// CLINT's msip registers.  Only mie.MSIE is set, so the interrupt wakes
+// the hart without trapping.  Waits must re-check their condition.
+#ifdef WFI_WAIT
+#ifndef CLINT
+# define CLINT 0x2000000
+#endif
+#define MSIP ((volatile uint32_t*)(CLINT))
+
+static inline void hart_sleep()
+{
+  asm volatile ("wfi");
+  MSIP[read_csr(mhartid)] = 0;
+  asm volatile ("fence" ::: "memory");
+}
+
+static inline void hart_wake(int hart)
+{
+  asm volatile ("fence" ::: "memory");
+  MSIP[hart] = 1;
+}
+#else
+static inline void hart_sleep() {}
+static inline void hart_wake(int hart) {}
+#endif
+
+static inline void hart_wake_others(int ncores)
+{
+#ifdef WFI_WAIT
+  int cid = read_csr(mhartid);
+  for (int i = 0; i < ncores; i++)
+    if (i != cid)
+      hart_wake(i);
+#endif
+}
+
+// Three barriers share one interface: a centralized sense-reversing
+// counter, an MCS-style tree barrier (4-ary arrival, binary wakeup) and a
+// dissemination barrier.  The latter two only ever spin on the calling
+// hart's own cache line.  barrier() is the centralized one unless built
+// with -DBARRIER_TREE or -DBARRIER_DISSEMINATION.  All participating
+// harts must have IDs 0..ncores-1.
+
+#define BARRIER_FANIN 4
+#define BARRIER_ROUNDS 6 // log2 of the most harts we can synchronize
+
+#if MAX_HARTS > (1 << BARRIER_ROUNDS)
+# error "MAX_HARTS is more than the dissemination barrier can synchronize"
+#endif
+
+typedef struct {
+  volatile int child_sense[BARRIER_FANIN];
+  volatile int parent_sense;
+  volatile int flags[2][BARRIER_ROUNDS];
+} __attribute__((aligned(CACHE_LINE_SIZE))) barrier_node_t;
+
 typedef struct {
   volatile int sense;
   volatile int count;
+  barrier_node_t node[MAX_HARTS];
 } barrier_global_data_t;
 
 typedef struct {
   int ncores;
   int threadsense;
+  int parity;
 } barrier_local_data_t;
 
-static void __attribute__((noinline)) barrier(barrier_global_data_t* global, barrier_local_data_t* local)
+static void __attribute__((noinline)) barrier_central(barrier_global_data_t* global, barrier_local_data_t* local)
 {
   int threadsense = !local->threadsense;
   local->threadsense = threadsense;
@@ -76,8 +290,71 @@ static void __attribute__((noinline)) barrier(barrier_global_data_t* global, bar
   if (atomic_fetch_add_explicit(&global->count, 1, memory_order_acq_rel) == local->ncores - 1) {
     atomic_store_explicit(&global->count, 0, memory_order_relaxed);
     atomic_store_explicit(&global->sense, threadsense, memory_order_release);
+    hart_wake_others(local->ncores);
   } else while (atomic_load_explicit(&global->sense, memory_order_acquire) != threadsense)
-    ;
+    hart_sleep();
+}
+
+static void __attribute__((noinline)) barrier_tree(barrier_global_data_t* global, barrier_local_data_t* local)
+{
+  int cid = read_csr(mhartid), n = local->ncores;
+  barrier_node_t* node = &global->node[cid];
+  int threadsense = !local->threadsense;
+  local->threadsense = threadsense;
+
+  // wait for our children in the arrival tree, then tell our parent
+  for (int i = 0; i < BARRIER_FANIN; i++)
+    if (BARRIER_FANIN*cid + i + 1 < n)
+      while (atomic_load_explicit(&node->child_sense[i], memory_order_acquire) != threadsense)
+        hart_sleep();
+
+  if (cid != 0) {
+    barrier_node_t* parent = &global->node[(cid-1) / BARRIER_FANIN];
+    atomic_store_explicit(&parent->child_sense[(cid-1) % BARRIER_FANIN], threadsense, memory_order_release);
+    hart_wake((cid-1) / BARRIER_FANIN);
+    while (atomic_load_explicit(&node->parent_sense, memory_order_acquire) != threadsense)
+      hart_sleep();
+  }
+
+  // release our children in the wakeup tree
+  for (int i = 1; i <= 2; i++) {
+    if (2*cid + i < n) {
+      atomic_store_explicit(&global->node[2*cid + i].parent_sense, threadsense, memory_order_release);
+      hart_wake(2*cid + i);
+    }
+  }
+}
+
+static void __attribute__((noinline)) barrier_dissemination(barrier_global_data_t* global, barrier_local_data_t* local)
+{
+  int cid = read_csr(mhartid), n = local->ncores;
+  barrier_node_t* node = &global->node[cid];
+  int parity = local->parity, sense = !local->threadsense;
+
+  // in round r, signal hart cid+2^r and wait for hart cid-2^r
+  for (int r = 0, d = 1; d < n; r++, d *= 2) {
+    barrier_node_t* partner = &global->node[(cid + d) % n];
+    atomic_store_explicit(&partner->flags[parity][r], sense, memory_order_release);
+    hart_wake((cid + d) % n);
+    while (atomic_load_explicit(&node->flags[parity][r], memory_order_acquire) != sense)
+      hart_sleep();
+  }
+
+  // flags alternate by parity; the sense flips every other episode
+  if (parity)
+    local->threadsense = sense;
+  local->parity = !parity;
+}
+
+static inline void barrier(barrier_global_data_t* global, barrier_local_data_t* local)
+{
+#if defined(BARRIER_TREE)
+  barrier_tree(global, local);
+#elif defined(BARRIER_DISSEMINATION)
+  barrier_dissemination(global, local);
+#else
+  barrier_central(global, local);
+#endif
 }
 
 static uint64_t lfsr(uint64_t x)
@@ -91,19 +368,45 @@ static uintptr_t insn_len(uintptr_t pc)
   return (*(unsigned short*)pc & 3) ? 4 : 2;
 }
 
-#ifdef __riscv
-#include "encoding.h"
-#endif
-
 #define stringify_1(s) #s
 #define stringify(s) stringify_1(s)
+// Every hart must run stats() together.  Each records its own counters;
+// hart 0 then reports the slowest hart's cycles and, with more than one
+// hart, the spread of each counter across harts.
 #define stats(code, iter) do { \
-    unsigned long _c = -read_csr(mcycle), _i = -read_csr(minstret); \
+    setStats(1); \
     code; \
-    _c += read_csr(mcycle), _i += read_csr(minstret); \
-    if (cid == 0) \
-      printf("\n%s: %ld cycles, %ld.%ld cycles/iter, %ld.%ld CPI\n", \
-             stringify(code), _c, _c/iter, 10*_c/iter%10, _c/_i, 10*_c/_i%10); \
+    setStats(0); \
+    reportStats(stringify(code), iter); \
   } while(0)
 
+// Timing harness.  bench() runs code BENCH_WARMUP times untimed, then
+// BENCH_REPS times timed, and reports the min, median and max of each
+// counter on the calling hart; the median run is what goes into the
+// result record.  benchCold() skips the warm-up and runs flush, e.g.
+// flushCaches() on the kernel's data, before every timed run.  Both
+// evaluate to the median cycle count.
+#ifndef BENCH_REPS
+# define BENCH_REPS 5
+#endif
+#ifndef BENCH_WARMUP
+# define BENCH_WARMUP 1
+#endif
+
+#define bench_runs(name, code, iter, warmup, flush) ({ \
+    for (int bench_i = -(warmup); bench_i < BENCH_REPS; bench_i++) { \
+      flush; \
+      setStats(1); \
+      code; \
+      setStats(0); \
+      if (bench_i >= 0) benchSample(bench_i); \
+    } \
+    benchReport(name, iter); \
+  })
+
+#define bench(code, iter) \
+  bench_runs(stringify(code), code, iter, BENCH_WARMUP, )
+#define benchCold(code, iter, flush) \
+  bench_runs(stringify(code) " (cold)", code, iter, 0, flush)
+
 #endif //__UTIL_H
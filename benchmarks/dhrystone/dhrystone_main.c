@@ -111,6 +111,7 @@ int main (int argc, char** argv)
     /* Start timer */
     /***************/
 
+    setStatsSize(Number_Of_Runs);
     setStats(1);
     Start_Timer();
 
@@ -31,6 +31,7 @@ int main( int argc, char* argv[] )
 #endif
 
   // Do the filter
+  setStatsSize(DATA_SIZE);
   setStats(1);
   median( DATA_SIZE, input_data, results_data );
   setStats(0);
@@ -30,6 +30,7 @@ int main( int argc, char* argv[] )
 #endif
 
   // Do the riscv-linux memcpy
+  setStatsSize(DATA_SIZE);
   setStats(1);
   memcpy(results_data, input_data, sizeof(int) * DATA_SIZE); //, DATA_SIZE * sizeof(int));
   setStats(0);
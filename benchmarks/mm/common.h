@@ -16,8 +16,6 @@ typedef double t;
 
 #define inline inline __attribute__((always_inline))
 
-#define alloca_aligned(s, a) ((void*)(((uintptr_t)alloca((s)+(a)-1)+(a)-1)&~((a)-1)))
-
 #include "rb.h"
 
 #ifdef __cplusplus
@@ -27,6 +25,9 @@ extern "C" {
 void mm(size_t m, size_t n, size_t p,
         t* a, size_t lda, t* b, size_t ldb, t* c, size_t ldc);
 
+size_t mm_mt(size_t cid, size_t nc, size_t m, size_t n, size_t p,
+             t* a, size_t lda, t* b, size_t ldb, t* c, size_t ldc);
+
 #ifdef __cplusplus
 }
 #endif
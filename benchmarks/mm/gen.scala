@@ -57,25 +57,115 @@ object MMGen {
 
     s
   }
+  def vdefs(sew: Int, lmul: Int) = {
+    val v = "f" + sew + "m" + lmul
+    "typedef vfloat" + sew + "m" + lmul + "_t rv_vt;\n" +
+    "#define rv_vsetvlmax __riscv_vsetvlmax_e" + sew + "m" + lmul + "\n" +
+    "#define rv_vsetvl __riscv_vsetvl_e" + sew + "m" + lmul + "\n" +
+    "#define rv_vle __riscv_vle" + sew + "_v_" + v + "\n" +
+    "#define rv_vse __riscv_vse" + sew + "_v_" + v + "\n" +
+    "#define rv_vfmacc __riscv_vfmacc_vf_" + v + "\n"
+  }
+
+  // RVV kloop: m rows of c by n register groups of lmul vectors, each
+  // k step adding a broadcast element of a times a vector row of b (the
+  // c and b groups must fit the 32 vector registers together).  It
+  // is vector-length agnostic and covers any number of columns: strips
+  // n*VLMAX wide, then one group at a time down to the last vl.
+  def rbv(m: Int, n: Int, p: Int, lmul: Int) = {
+    require((m + p)*n*lmul <= 32, "register block needs more than 32 vector registers")
+
+    var s = "#define RB_VECTOR 1\n" +
+            "static const int RB_LMUL = " + lmul + ";\n" +
+            "#include <riscv_vector.h>\n" +
+            "#ifdef SP\n" + vdefs(32, lmul) + "#else\n" + vdefs(64, lmul) + "#endif\n"
+    s += open_block("static inline void kloop(size_t p, size_t n, t* a0, size_t lda, t* b0, size_t ldb, t* c, size_t ldc)\n")
+    s += init("size_t", "j", "0")
+
+    def strip(n: Int) = {
+      for (i <- 0 until m; j <- 0 until n)
+        s += init("rv_vt", r("c", i, j), "rv_vle(&" + ar("c", "ldc*"+i+" + j + vl*"+j) + ", vl)")
+
+      def doit(p: Int) = {
+        for (k <- 0 until p; j <- 0 until n)
+          s += init("rv_vt", r("b", k, j), "rv_vle(&" + ar("b", "ldb*"+k+" + vl*"+j) + ", vl)")
+        for (k <- 0 until p; i <- 0 until m; j <- 0 until n)
+          s += assign(r("c", i, j), "rv_vfmacc(" + r("c", i, j) + ", " + ar("a", "lda*"+i+" + "+k) + ", " + r("b", k, j) + ", vl)")
+      }
+
+      s += open_block("for (t *a = a0, *b = b0 + j; a < a0 + p/RBK*RBK; a += RBK, b += RBK*ldb)\n")
+      doit(p)
+      s += close_block
+
+      s += open_block("for (t *a = a0 + p/RBK*RBK, *b = b0 + j + p/RBK*RBK*ldb; a < a0 + p; a++, b += ldb)\n")
+      doit(1)
+      s += close_block
+
+      for (i <- 0 until m; j <- 0 until n)
+        s += spacing + "rv_vse(&" + ar("c", "ldc*"+i+" + j + vl*"+j) + ", " + r("c", i, j) + ", vl);\n"
+    }
+
+    s += open_block("for (size_t vl = rv_vsetvlmax(); j + RBN*vl <= n; j += RBN*vl)\n")
+    strip(n)
+    s += close_block
+
+    s += open_block("for (size_t vl; j < n; j += vl)\n")
+    s += assign("vl", "rv_vsetvl(n - j)")
+    strip(1)
+    s += close_block
+
+    s += close_block
+    s
+  }
   def gcd(a: Int, b: Int): Int = if (b == 0) a else gcd(b, a%b)
   def lcm(a: Int, b: Int): Int = a*b/gcd(a, b)
   def lcm(a: Seq[Int]): Int = {
     if (a.tail.isEmpty) a.head
     else lcm(a.head, lcm(a.tail))
   }
-  def test1(m: Int, n: Int, p: Int, m1: Int, n1: Int, p1: Int) = {
-    val decl = "static const int RBM = "+m+", RBN = "+n+", RBK = "+p+";\n" +
-               "static const int CBM = "+m1+", CBN = "+n1+", CBK = "+p1+";\n"
-    writeFile("rb.h", decl + rb(m, n, p))
-    //"make"!!
+  def decl(m: Int, n: Int, p: Int, m1: Int, n1: Int, p1: Int) =
+    "static const int RBM = "+m+", RBN = "+n+", RBK = "+p+";\n" +
+    "static const int CBM = "+m1+", CBN = "+n1+", CBK = "+p1+";\n"
 
-    "make run"!
+  // Build and run mm with the given rb.h, returning its Mflops line
+  val mflops = """\d+ harts: \d+ Mflops @ 1 GHz, \d+ cold""".r
+  def test1(rbh: String, march: String) = {
+    writeFile("rb.h", rbh)
+    if (Seq("make", "-C", "..", "-B", "mm.riscv.out", "RISCV_MARCH="+march).! != 0)
+      "failed"
+    else
+      mflops.findFirstIn(scala.io.Source.fromFile("../mm.riscv.out").mkString).getOrElse("no result")
+  }
 
-    ("cp a.out " + Seq("b", m, n, p, m1, n1, p1, "run").reduce(_+"."+_))!
+  // Time every block shape, leaving rb.h as it was
+  def sweep(shapes: Seq[(String, String)], march: String) = {
+    val saved = scala.io.Source.fromFile("rb.h").mkString
+    try {
+      val results = for ((name, rbh) <- shapes) yield (name, test1(rbh, march))
+      for ((name, result) <- results)
+        println(name + ": " + result)
+    } finally {
+      writeFile("rb.h", saved)
+    }
   }
-  def main(args: Array[String]): Unit = {
-    test1(4, 5, 6, 24, 25, 24)
-    //for (i <- 4 to 6; j <- 4 to 6; k <- 4 to 6)
-    //  test1(i, j, k, if (i == 5) 35 else 36, if (j == 5) 35 else 36, if (k == 5) 35 else 36)
+
+  def main(args: Array[String]): Unit = args.toList match {
+    case "rb" :: dims =>
+      val Seq(m, n, p, m1, n1, p1) = dims.map(_.toInt)
+      writeFile("rb.h", decl(m, n, p, m1, n1, p1) + rb(m, n, p))
+    case "rbv" :: dims =>
+      val Seq(m, n, p, lmul, m1, n1, p1) = dims.map(_.toInt)
+      writeFile("rb.h", decl(m, n, p, m1, n1, p1) + rbv(m, n, p, lmul))
+    case List("sweep", march) =>
+      sweep(for (i <- 4 to 6; j <- 4 to 6; k <- 4 to 6) yield {
+        val (m1, n1, p1) = (if (i == 5) 35 else 36, if (j == 5) 35 else 36, if (k == 5) 35 else 36)
+        ("rb "+i+"x"+j+"x"+k, decl(i, j, k, m1, n1, p1) + rb(i, j, k))
+      }, march)
+    case List("vsweep", march) =>
+      sweep(for (lmul <- Seq(1, 2, 4); i <- Seq(2, 4, 6, 8); j <- Seq(1, 2); k <- Seq(1, 2)
+                 if (i + k)*j*lmul <= 32) yield
+        ("rbv "+i+"x"+j+"x"+k+" m"+lmul, decl(i, j, k, 24, 50, 24) + rbv(i, j, k, lmul)), march)
+    case _ =>
+      writeFile("rb.h", decl(4, 5, 6, 24, 25, 24) + rb(4, 5, 6))
   }
 }
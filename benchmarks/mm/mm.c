@@ -4,7 +4,7 @@
 #include <assert.h>
 #include <math.h>
 #include <stdint.h>
-#include <alloca.h>
+#include "util.h"
 
 #define MIN(a, b) ((a) < (b) ? (a) : (b))
 
@@ -33,6 +33,12 @@ static void mm_naive(size_t m, size_t n, size_t p,
 static inline void mm_rb(size_t m, size_t n, size_t p,
                          t* a, size_t lda, t* b, size_t ldb, t* c, size_t ldc)
 {
+#ifdef RB_VECTOR
+  // the vector kloop strip-mines the whole row band itself
+  size_t mb = m/RBM*RBM;
+  for (size_t i = 0; i < mb; i += RBM)
+    kloop(p, n, a+i*lda, lda, b, ldb, c+i*ldc, ldc);
+#else
   size_t mb = m/RBM*RBM, nb = n/RBN*RBN;
   for (size_t i = 0; i < mb; i += RBM)
   {
@@ -40,6 +46,7 @@ static inline void mm_rb(size_t m, size_t n, size_t p,
       kloop(p, a+i*lda, lda, b+j, ldb, c+i*ldc+j, ldc);
     mm_naive(RBM, n - nb, p, a+i*lda, lda, b+nb, ldb, c+i*ldc+nb, ldc);
   }
+#endif
   mm_naive(m - mb, n, p, a+mb*lda, lda, b, ldb, c+mb*ldc, ldc);
 }
 
@@ -77,9 +84,10 @@ static void mm_cb(size_t m, size_t n, size_t p,
   size_t nmb = m/CBM, nnb = n/CBN, npb = p/CBK;
   size_t mb = nmb*CBM, nb = nnb*CBN, pb = npb*CBK;
   //t a1[mb*pb], b1[pb*nb], c1[mb*nb];
-  t* a1 = (t*)alloca_aligned(sizeof(t)*mb*pb, 8192);
-  t* b1 = (t*)alloca_aligned(sizeof(t)*pb*nb, 8192);
-  t* c1 = (t*)alloca_aligned(sizeof(t)*mb*nb, 8192);
+  void* mark = arena_mark();
+  t* a1 = (t*)arena_alloc(sizeof(t)*mb*pb, 8192);
+  t* b1 = (t*)arena_alloc(sizeof(t)*pb*nb, 8192);
+  t* c1 = (t*)arena_alloc(sizeof(t)*mb*nb, 8192);
 
     for (size_t i = 0; i < mb; i += CBM)
       for (size_t j = 0; j < pb; j += CBK)
@@ -140,6 +148,8 @@ static void mm_cb(size_t m, size_t n, size_t p,
     for (size_t i = 0; i < mb; i += CBM)
       for (size_t j = 0; j < nb; j += CBN)
         repack(c + i*ldc + j, ldc, c1 + (nnb*(i/CBM) + j/CBN)*(CBM*CBN), CBN, CBM, CBN);
+
+  arena_release(mark);
 }
 
 void mm(size_t m, size_t n, size_t p,
@@ -150,3 +160,81 @@ void mm(size_t m, size_t n, size_t p,
   else
     mm_cb(m, n, p, a, lda, b, ldb, c, ldc);
 }
+
+// Parallel cache-blocked multiply.  The grid of CBM x CBN tiles of c is
+// split row-major into one contiguous range of tiles per hart, so a hart
+// mostly owns whole tile rows and packs the A panels for them privately.
+// B is packed once, each hart taking a slice of the CBK-deep block rows
+// into its own arena; tiles that don't fill a whole block are computed
+// from the unpacked inputs.  All harts must call it together; it returns
+// the number of flops the calling hart performed.
+static barrier_global_data_t mm_bar;
+static __thread barrier_local_data_t mm_lbar;
+static t* mm_bpack[MAX_HARTS];
+
+static inline size_t slice(size_t n, size_t i, size_t nc)
+{
+  return n*i/nc;
+}
+
+size_t mm_mt(size_t cid, size_t nc, size_t m, size_t n, size_t p,
+             t* a, size_t lda, t* b, size_t ldb, t* c, size_t ldc)
+{
+  size_t nmb = m/CBM, nnb = n/CBN, npb = p/CBK;
+  size_t pb = npb*CBK;
+  size_t ntm = (m + CBM - 1)/CBM, ntn = (n + CBN - 1)/CBN;
+  size_t t0 = slice(ntm*ntn, cid, nc), t1 = slice(ntm*ntn, cid+1, nc);
+  size_t ti0 = t0/ntn, ti1 = MIN(t1 ? (t1-1)/ntn + 1 : 0, nmb);
+  size_t kb0 = slice(npb, cid, nc), kb1 = slice(npb, cid+1, nc);
+  size_t flops = 0;
+
+  mm_lbar.ncores = nc;
+  void* mark = arena_mark();
+
+  // this hart's slice of B, as npb x nnb tiles of CBK x CBN
+  t* b1 = (t*)arena_alloc(sizeof(t)*(kb1-kb0)*CBK*nnb*CBN, 8192);
+  for (size_t k = kb0; k < kb1; k++)
+    for (size_t j = 0; j < nnb; j++)
+      repack(b1 + ((k-kb0)*nnb + j)*(CBK*CBN), CBN, b + k*CBK*ldb + j*CBN, ldb, CBK, CBN);
+  mm_bpack[cid] = b1;
+
+  // the A panels for this hart's full tile rows, as npb tiles of CBM x CBK
+  t* a1 = (t*)arena_alloc(sizeof(t)*(ti1 > ti0 ? ti1-ti0 : 0)*CBM*pb, 8192);
+  for (size_t i = ti0; i < ti1; i++)
+    for (size_t k = 0; k < npb; k++)
+      repack(a1 + ((i-ti0)*npb + k)*(CBM*CBK), CBK, a + i*CBM*lda + k*CBK, lda, CBM, CBK);
+
+  barrier(&mm_bar, &mm_lbar);
+
+  for (size_t tile = t0; tile < t1; tile++)
+  {
+    size_t i = tile/ntn*CBM, j = tile%ntn*CBN;
+    size_t mi = MIN(m - i, CBM), nj = MIN(n - j, CBN);
+    t* cij = c + i*ldc + j;
+    flops += 2*mi*nj*p;
+
+    if (mi < CBM || nj < CBN)
+    {
+      for (size_t k = 0; k < p; k += CBK)
+        mm_rb(mi, nj, MIN(p - k, CBK), a + i*lda + k, lda, b + k*ldb + j, ldb, cij, ldc);
+      continue;
+    }
+
+    for (size_t k = 0, h = 0; k < npb; k++)
+    {
+      while (k >= slice(npb, h+1, nc))
+        h++;
+      mm_rb(CBM, CBN, CBK,
+            a1 + ((i/CBM-ti0)*npb + k)*(CBM*CBK), CBK,
+            mm_bpack[h] + ((k-slice(npb, h, nc))*nnb + j/CBN)*(CBK*CBN), CBN,
+            cij, ldc);
+    }
+    if (pb < p)
+      mm_rb(CBM, CBN, p - pb, a + i*lda + pb, lda, b + pb*ldb + j, ldb, cij, ldc);
+  }
+
+  // keep every slice of B around until nobody needs it
+  barrier(&mm_bar, &mm_lbar);
+  arena_release(mark);
+  return flops;
+}
@@ -8,67 +8,93 @@
 
 #pragma GCC optimize ("unroll-loops")
 
+// All harts share one m x p by p x n product, by default four cache
+// blocks in each dimension.
+#ifndef MM_M
+# define MM_M 96
+#endif
+#ifndef MM_N
+# define MM_N 100
+#endif
+#ifndef MM_P
+# define MM_P 96
+#endif
+
 static barrier_global_data_t bar;
+static t a[MM_M*MM_P], b[MM_P*MM_N], c[MM_M*MM_N];
+static size_t cycles[MAX_HARTS], cold[MAX_HARTS];
 
 void thread_entry(int cid, int nc)
 {
-  const int R = 8;
-  int m, n, p;
-  uint64_t s = 0xdeadbeefU;
+  // every warm-up, warm and cold run accumulates into c
+  const int R = BENCH_WARMUP + 2*BENCH_REPS;
+  const size_t m = MM_M, n = MM_N, p = MM_P;
   barrier_local_data_t lbar = {nc};
-  
-  m = CBM;
-  n = CBN;
-  p = CBK;
+  size_t flops;
 
-  t a[m*p];
-  t b[p*n];
-  t c[m*n];
-
-  for (size_t i = 0; i < m; i++)
-    for (size_t j = 0; j < p; j++)
-      a[i*p+j] = (t)(s = lfsr(s));
-  for (size_t i = 0; i < p; i++)
-    for (size_t j = 0; j < n; j++)
-      b[i*n+j] = (t)(s = lfsr(s));
-  memset(c, 0, m*n*sizeof(c[0]));
-
-  size_t instret, cycles;
-  for (int i = 0; i < R; i++)
+  if (cid == 0)
   {
-    instret = -read_csr(minstret);
-    cycles = -read_csr(mcycle);
-    mm(m, n, p, a, p, b, n, c, n);
-    instret += read_csr(minstret);
-    cycles += read_csr(mcycle);
+    uint64_t s = 0xdeadbeefU;
+    for (size_t i = 0; i < m; i++)
+      for (size_t j = 0; j < p; j++)
+        a[i*p+j] = (t)(s = lfsr(s));
+    for (size_t i = 0; i < p; i++)
+      for (size_t j = 0; j < n; j++)
+        b[i*n+j] = (t)(s = lfsr(s));
+
+#ifdef RB_VECTOR
+    printf("reg block %dx%d m%d vectors x %d, ", RBM, RBN, RB_LMUL, RBK);
+#else
+    printf("reg block %dx%dx%d, ", RBM, RBN, RBK);
+#endif
+    printf("cache block %dx%dx%d, %dx%dx%d on %d harts\n",
+           CBM, CBN, CBK, (int)m, (int)n, (int)p, nc);
   }
+  barrier(&bar, &lbar);
+
+  cycles[cid] = bench(flops = mm_mt(cid, nc, m, n, p, a, p, b, n, c, n), flops);
+  cold[cid] = benchCold(flops = mm_mt(cid, nc, m, n, p, a, p, b, n, c, n), flops,
+                        if (cid == 0) {
+                          flushCaches(a, sizeof(a));
+                          flushCaches(b, sizeof(b));
+                          flushCaches(c, sizeof(c));
+                        }
+                        barrier(&bar, &lbar));
 
   asm volatile("fence");
 
-  printf("C%d: reg block %dx%dx%d, cache block %dx%dx%d\n",
-         cid, RBM, RBN, RBK, CBM, CBN, CBK);
-  printf("C%d: %d instructions\n", cid, (int)(instret));
-  printf("C%d: %d cycles\n", cid, (int)(cycles));
-  printf("C%d: %d flops\n", cid, 2*m*n*p);
-  printf("C%d: %d Mflops @ 1 GHz\n", cid, 2000*m*n*p/(cycles));
+  printf("C%d: %d flops, %d Mflops @ 1 GHz, %d cold\n", cid, (int)flops,
+         (int)(1000*flops/cycles[cid]), (int)(1000*flops/cold[cid]));
+  barrier(&bar, &lbar);
 
-#if 1
-  for (size_t i = 0; i < m; i++)
+  if (cid == 0)
   {
-    for (size_t j = 0; j < n; j++)
+    // the aggregate rate is set by the slowest hart
+    size_t slowest = 0, slowest_cold = 0;
+    for (int h = 0; h < nc; h++)
     {
-      t s = 0;
-      for (size_t k = 0; k < p; k++)
-        s += a[i*p+k] * b[k*n+j];
-      s *= R;
-      if (fabs(c[i*n+j]-s) > fabs(1e-6*s))
+      slowest = cycles[h] > slowest ? cycles[h] : slowest;
+      slowest_cold = cold[h] > slowest_cold ? cold[h] : slowest_cold;
+    }
+    printf("%d harts: %d Mflops @ 1 GHz, %d cold\n", nc,
+           (int)(2000*m*n*p/slowest), (int)(2000*m*n*p/slowest_cold));
+
+    for (size_t i = 0; i < m; i++)
+    {
+      for (size_t j = 0; j < n; j++)
       {
-        printf("C%d: c[%lu][%lu] %f != %f\n", cid, i, j, c[i*n+j], s);
-        exit(1);
+        t s = 0;
+        for (size_t k = 0; k < p; k++)
+          s += a[i*p+k] * b[k*n+j];
+        s *= R;
+        if (fabs(c[i*n+j]-s) > fabs(1e-6*s))
+        {
+          printf("C%d: c[%lu][%lu] %f != %f\n", cid, i, j, c[i*n+j], s);
+          exit(1);
+        }
       }
     }
   }
-#endif
 
   barrier(&bar, &lbar);
   exit(0);
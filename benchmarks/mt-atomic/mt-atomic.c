@@ -0,0 +1,163 @@
+// See LICENSE for license details.
+
+//**************************************************************************
+// Atomic operation throughput benchmark
+//--------------------------------------------------------------------------
+//
+// This benchmark measures how many atomic updates the harts get through
+// per cycle, for every hart count from 1 up to the number of harts
+// present:
+//
+//   amoadd    every hart does amoadd on one shared counter
+//   lr/sc     every hart increments the shared counter with an LR/SC loop
+//   padded    every hart does amoadd on its own counter, alone in its
+//             cache line
+//   fence     every hart stores to its own padded line, then fences
+//
+// The first two show what contention for one line costs, the last two
+// what an uncontended AMO and a fence cost.  Harts beyond the count being
+// measured wait out that round.  The counters are checked after every
+// round.  They are XLEN wide, so the AMOs are .w on RV32 and .d on RV64.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include "util.h"
+
+#define NUM_OPS 1024
+
+static volatile uintptr_t shared __attribute__((aligned(CACHE_LINE_SIZE)));
+static struct {
+  volatile uintptr_t n;
+} __attribute__((aligned(CACHE_LINE_SIZE))) padded[MAX_HARTS];
+
+static void op_amoadd(volatile uintptr_t* p, size_t n)
+{
+  for (size_t i = 0; i < n; i++)
+    asm volatile ("amoadd" AMO_WIDTH " zero, %1, %0" : "+A"(*p) : "r"((uintptr_t)1));
+}
+
+static void op_lrsc(volatile uintptr_t* p, size_t n)
+{
+  for (size_t i = 0; i < n; i++)
+  {
+    uintptr_t x, fail;
+    asm volatile ("1: lr" AMO_WIDTH " %0, %2\n"
+                  "   addi %0, %0, 1\n"
+                  "   sc" AMO_WIDTH " %1, %0, %2\n"
+                  "   bnez %1, 1b"
+                  : "=&r"(x), "=&r"(fail), "+A"(*p));
+  }
+}
+
+static void op_fence(volatile uintptr_t* p, size_t n)
+{
+  for (size_t i = 0; i < n; i++)
+  {
+    *p = i + 1;
+    asm volatile ("fence rw, rw" ::: "memory");
+  }
+}
+
+typedef void (*op_fn_t)(volatile uintptr_t*, size_t);
+
+static const struct {
+  const char* name;
+  op_fn_t fn;
+  int shared;   // all harts update the one counter
+  int sum;      // the counter ends up counting every update
+} ops[] = {
+  { "amoadd", op_amoadd, 1, 1 },
+  { "lr/sc", op_lrsc, 1, 1 },
+  { "padded", op_amoadd, 0, 1 },
+  { "fence", op_fence, 0, 0 },
+};
+
+#define NUM_VARIANTS (sizeof(ops) / sizeof(ops[0]))
+
+static barrier_global_data_t bar;
+static size_t cycles[MAX_HARTS];
+// ops/cycle in thousandths, by hart count and variant
+static size_t result[MAX_HARTS][NUM_VARIANTS];
+
+static void print_opc(size_t opc)
+{
+  printf("%4d.%03d", (int)(opc/1000), (int)(opc%1000));
+}
+
+// The counter should have been updated NUM_OPS times per run by each of
+// the k harts sharing it.
+static int check(int v, int k)
+{
+  uintptr_t runs = BENCH_WARMUP + BENCH_REPS;
+  if (ops[v].shared)
+    return shared != runs*k*NUM_OPS;
+  for (int h = 0; h < k; h++)
+    if (padded[h].n != (ops[v].sum ? runs*NUM_OPS : NUM_OPS))
+      return 1;
+  return 0;
+}
+
+//--------------------------------------------------------------------------
+// Main
+
+void thread_entry(int cid, int nc)
+{
+  barrier_local_data_t lbar = {nc};
+  int res = 0;
+
+  for (int v = 0; v < NUM_VARIANTS; v++)
+  {
+    volatile uintptr_t* p = ops[v].shared ? &shared : &padded[cid].n;
+
+    for (int k = 1; k <= nc; k++)
+    {
+      *p = 0;
+      barrier(&bar, &lbar);
+      cycles[cid] = bench_runs(ops[v].name, if (cid < k) ops[v].fn(p, NUM_OPS), NUM_OPS,
+                               BENCH_WARMUP, barrier(&bar, &lbar));
+      barrier(&bar, &lbar);
+
+      if (cid == 0)
+      {
+        size_t slowest = 0;
+        for (int h = 0; h < k; h++)
+          slowest = cycles[h] > slowest ? cycles[h] : slowest;
+        size_t opc = 1000*k*NUM_OPS/slowest;
+        result[k-1][v] = opc;
+        printf("%s, %d harts:", ops[v].name, k);
+        print_opc(opc);
+        printf(" ops/cycle\n");
+        if (check(v, k))
+        {
+          printf("%s, %d harts: wrong result\n", ops[v].name, k);
+          res = 1;
+        }
+      }
+      barrier(&bar, &lbar);
+    }
+  }
+
+  if (cid == 0)
+  {
+    printf("ops/cycle");
+    for (int v = 0; v < NUM_VARIANTS; v++)
+      printf(" %8s", ops[v].name);
+    printf("\n");
+    for (int k = 1; k <= nc; k++)
+    {
+      printf("%3d harts", k);
+      for (int v = 0; v < NUM_VARIANTS; v++)
+      {
+        printf(" ");
+        print_opc(result[k-1][v]);
+      }
+      printf("\n");
+    }
+    if (res)
+      exit(res);
+  }
+
+  barrier(&bar, &lbar);
+  exit(0);
+}
@@ -0,0 +1,77 @@
+// See LICENSE for license details.
+
+//**************************************************************************
+// Barrier latency benchmark
+//--------------------------------------------------------------------------
+//
+// This benchmark measures the latency of each barrier in util.h for every
+// hart count from 1 up to the number of harts present.  Harts beyond the
+// count being measured wait out that round.  Each barrier is first checked
+// to hold back every hart until all of them have arrived.
+
+#include <stdlib.h>
+#include <stdio.h>
+#include "util.h"
+
+#define NUM_CHECKS 16
+#define NUM_ITERS 256
+
+typedef void (*barrier_fn_t)(barrier_global_data_t*, barrier_local_data_t*);
+
+static const struct {
+  const char* name;
+  barrier_fn_t fn;
+} barriers[] = {
+  { "central", barrier_central },
+  { "tree", barrier_tree },
+  { "dissemination", barrier_dissemination },
+};
+
+#define NUM_BARRIERS (sizeof(barriers) / sizeof(barriers[0]))
+
+static barrier_global_data_t bar;
+static barrier_global_data_t test_bar[NUM_BARRIERS][MAX_HARTS];
+static volatile int arrived[NUM_BARRIERS][MAX_HARTS];
+
+//--------------------------------------------------------------------------
+// Main
+//
+// all threads start executing thread_entry(). Use their "coreid" to
+// differentiate between threads (each thread is running on a separate core).
+
+void thread_entry(int cid, int nc)
+{
+  barrier_local_data_t lbar = {nc};
+
+  for (int b = 0; b < NUM_BARRIERS; b++) {
+    for (int n = 1; n <= nc; n++) {
+      barrier(&bar, &lbar);
+      if (cid >= n)
+        continue;
+
+      barrier_global_data_t* g = &test_bar[b][n-1];
+      barrier_local_data_t l = {n};
+
+      for (int i = 0; i < NUM_CHECKS; i++) {
+        atomic_fetch_add_explicit(&arrived[b][n-1], 1, memory_order_relaxed);
+        barriers[b].fn(g, &l);
+        if (atomic_load_explicit(&arrived[b][n-1], memory_order_relaxed) < n*(i+1)) {
+          printf("%s barrier, %d harts: C%d left early\n", barriers[b].name, n, cid);
+          exit(1);
+        }
+      }
+
+      unsigned long cycles = -read_csr(mcycle);
+      for (int i = 0; i < NUM_ITERS; i++)
+        barriers[b].fn(g, &l);
+      cycles += read_csr(mcycle);
+
+      if (cid == 0)
+        printf("%s barrier, %d harts: %ld cycles/barrier\n",
+               barriers[b].name, n, cycles / NUM_ITERS);
+    }
+  }
+
+  barrier(&bar, &lbar);
+  exit(0);
+}
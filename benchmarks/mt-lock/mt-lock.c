@@ -0,0 +1,120 @@
+// See LICENSE for license details.
+
+//**************************************************************************
+// Lock throughput and fairness benchmark
+//--------------------------------------------------------------------------
+//
+// This benchmark runs each lock in lock.h for every hart count from 1 up
+// to the number of harts present.  The harts share out k*NUM_ACQUIRES
+// critical sections between them: each takes the lock, bumps a shared
+// count if the total has not been reached, and lets the lock go.  The
+// count doubles as the check that the lock excludes.  For each lock and
+// hart count we report cycles per acquire/release, and, for fairness, the
+// fewest and most critical sections any one hart got.  Harts beyond the
+// count being measured wait out that round.
+
+#include <stdlib.h>
+#include <stdio.h>
+#include "util.h"
+#include "lock.h"
+
+#define NUM_ACQUIRES 256
+
+static ttas_lock_t ttas;
+static ticket_lock_t ticket;
+static mcs_lock_t mcs;
+static mcs_node_t nodes[MAX_HARTS];
+
+static void ttas_lock(mcs_node_t* me) { ttas_acquire(&ttas); }
+static void ttas_unlock(mcs_node_t* me) { ttas_release(&ttas); }
+static void ticket_lock(mcs_node_t* me) { ticket_acquire(&ticket); }
+static void ticket_unlock(mcs_node_t* me) { ticket_release(&ticket); }
+static void mcs_lock(mcs_node_t* me) { mcs_acquire(&mcs, me); }
+static void mcs_unlock(mcs_node_t* me) { mcs_release(&mcs, me); }
+
+typedef void (*lock_fn_t)(mcs_node_t*);
+
+static const struct {
+  const char* name;
+  lock_fn_t acquire, release;
+} locks[] = {
+  { "ttas", ttas_lock, ttas_unlock },
+  { "ticket", ticket_lock, ticket_unlock },
+  { "mcs", mcs_lock, mcs_unlock },
+};
+
+#define NUM_LOCKS (sizeof(locks) / sizeof(locks[0]))
+
+static barrier_global_data_t bar;
+static size_t cycles[MAX_HARTS];
+static volatile size_t count;   // only touched with the lock held
+static struct {
+  size_t n;
+} __attribute__((aligned(CACHE_LINE_SIZE))) got[MAX_HARTS];
+
+static void run(int b, int cid, size_t total)
+{
+  mcs_node_t* me = &nodes[cid];
+  size_t n = 0;
+  for (;;) {
+    locks[b].acquire(me);
+    int done = count >= total;
+    if (!done) {
+      count = count + 1;
+      n++;
+    }
+    locks[b].release(me);
+    if (done)
+      break;
+  }
+  got[cid].n = n;
+}
+
+// Wait for the last run to finish before starting the count again
+static void reset(int cid, barrier_local_data_t* lbar)
+{
+  barrier(&bar, lbar);
+  if (cid == 0)
+    count = 0;
+  barrier(&bar, lbar);
+}
+
+//--------------------------------------------------------------------------
+// Main
+
+void thread_entry(int cid, int nc)
+{
+  barrier_local_data_t lbar = {nc};
+  int res = 0;
+
+  for (int b = 0; b < NUM_LOCKS; b++) {
+    for (int k = 1; k <= nc; k++) {
+      size_t total = k*NUM_ACQUIRES;
+      barrier(&bar, &lbar);
+      cycles[cid] = bench_runs(locks[b].name, if (cid < k) run(b, cid, total), total,
+                               BENCH_WARMUP, reset(cid, &lbar));
+      barrier(&bar, &lbar);
+
+      if (cid == 0) {
+        size_t slowest = 0, min = total, max = 0, sum = 0;
+        for (int h = 0; h < k; h++) {
+          slowest = cycles[h] > slowest ? cycles[h] : slowest;
+          min = got[h].n < min ? got[h].n : min;
+          max = got[h].n > max ? got[h].n : max;
+          sum += got[h].n;
+        }
+        printf("%s lock, %d harts: %ld cycles/acquire, %ld to %ld acquires per hart\n",
+               locks[b].name, k, slowest / total, min, max);
+        if (count != total || sum != total) {
+          printf("%s lock, %d harts: wrong result\n", locks[b].name, k);
+          res = 1;
+        }
+      }
+    }
+  }
+
+  if (cid == 0 && res)
+    exit(res);
+  barrier(&bar, &lbar);
+  exit(0);
+}
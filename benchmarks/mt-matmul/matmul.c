@@ -11,9 +11,10 @@ void matmul(const size_t coreid, const size_t ncores, const size_t lda,  const d
   size_t i, j, k;
   size_t block = lda / ncores;
   size_t start = block * coreid;
+  size_t end = coreid == ncores - 1 ? lda : start + block;
  
   for (i = 0; i < lda; i++) {
-    for (j = start; j < (start+block); j++) {
+    for (j = start; j < end; j++) {
       data_t sum = 0;
       for (k = 0; k < lda; k++)
         sum += A[j*lda + k] * B[k*lda + i];
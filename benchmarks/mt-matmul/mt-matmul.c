@@ -51,7 +51,8 @@ void thread_entry(int cid, int nc)
    static data_t results_data[ARRAY_SIZE];
    barrier_local_data_t lbar = {nc};
 
-   stats(matmul(cid, nc, DIM_SIZE, input1_data, input2_data, results_data); barrier(&bar, &lbar), DIM_SIZE/DIM_SIZE/DIM_SIZE);
+   barrier(&bar, &lbar);
+   stats(matmul(cid, nc, DIM_SIZE, input1_data, input2_data, results_data), DIM_SIZE*DIM_SIZE*DIM_SIZE);
  
    int res = verify(ARRAY_SIZE, results_data, verify_data);
 
@@ -57,7 +57,7 @@ void thread_entry(int cid, int nc)
 #endif
 
    barrier(&bar, &lbar);
-   stats(memcpy(results_data + block * cid, input_data + block * cid, sizeof(long) * n); barrier(&bar, &lbar), DATA_SIZE);
+   stats(memcpy(results_data + block * cid, input_data + block * cid, sizeof(long) * n), DATA_SIZE);
    barrier(&bar, &lbar);
 
    if (cid == 0) {
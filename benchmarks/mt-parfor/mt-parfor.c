@@ -0,0 +1,123 @@
+// See LICENSE for license details.
+
+//**************************************************************************
+// parallel_for scheduling benchmark
+//--------------------------------------------------------------------------
+//
+// This benchmark runs two loops under each parallel_for() schedule on all
+// harts: vvadd, where every iteration costs the same, and a
+// self-convolution, where iteration i costs i multiply-adds, so equal
+// shares of iterations are far from equal shares of work.  Each result
+// is checked against a run on hart 0 alone.  With the loops themselves
+// short, the numbers include parallel_for()'s own overheads.
+
+#include <stdlib.h>
+#include <stdio.h>
+#include "util.h"
+#include "gendata.h"
+#include "parallel.h"
+
+#ifndef DATA_SIZE
+# define DATA_SIZE 1024
+#endif
+#ifndef GRAIN
+# define GRAIN 16
+#endif
+#define SEED1 1
+#define SEED2 2
+
+static int x[DATA_SIZE], y[DATA_SIZE], z[DATA_SIZE], ref[DATA_SIZE];
+
+static void gen(size_t lo, size_t hi, void* arg)
+{
+  gen_int(x, lo, hi, SEED1, 19);
+  gen_int(y, lo, hi, SEED2, 19);
+}
+
+static void clear(size_t lo, size_t hi, void* arg)
+{
+  int* out = arg;
+  for (size_t i = lo; i < hi; i++)
+    out[i] = 0;
+}
+
+static void vvadd(size_t lo, size_t hi, void* arg)
+{
+  int* out = arg;
+  for (size_t i = lo; i < hi; i++)
+    out[i] = x[i] + y[i];
+}
+
+static void conv(size_t lo, size_t hi, void* arg)
+{
+  int* out = arg;
+  for (size_t i = lo; i < hi; i++)
+  {
+    int s = 0;
+    for (size_t j = 0; j <= i; j++)
+      s += x[j] * y[i-j];
+    out[i] = s;
+  }
+}
+
+static const struct {
+  const char* name;
+  parallel_fn_t fn;
+} loops[] = {
+  { "vvadd", vvadd },
+  { "conv", conv },
+};
+
+static const char* sched_name[] = {"static", "chunked", "dynamic"};
+
+#define NUM_LOOPS (sizeof(loops) / sizeof(loops[0]))
+#define NUM_SCHEDS (sizeof(sched_name) / sizeof(sched_name[0]))
+
+static barrier_global_data_t bar;
+static size_t cycles[MAX_HARTS];
+
+//--------------------------------------------------------------------------
+// Main
+
+void thread_entry(int cid, int nc)
+{
+  barrier_local_data_t lbar = {nc};
+  int res = 0;
+
+  parallel_for(0, DATA_SIZE, GRAIN, gen, NULL);
+
+  for (int l = 0; l < NUM_LOOPS; l++)
+  {
+    if (cid == 0)
+      loops[l].fn(0, DATA_SIZE, ref);
+
+    for (sched_t s = 0; s < NUM_SCHEDS; s++)
+    {
+      barrier(&bar, &lbar);
+      cycles[cid] = bench_runs(sched_name[s],
+                               parallel_for_sched(s, 0, DATA_SIZE, GRAIN, loops[l].fn, z),
+                               DATA_SIZE, BENCH_WARMUP,
+                               parallel_for(0, DATA_SIZE, GRAIN, clear, z));
+      barrier(&bar, &lbar);
+
+      if (cid == 0)
+      {
+        size_t slowest = 0;
+        for (int h = 0; h < nc; h++)
+          slowest = cycles[h] > slowest ? cycles[h] : slowest;
+        printf("%s, %s schedule, %d harts: %ld cycles\n",
+               loops[l].name, sched_name[s], nc, slowest);
+        if (verify(DATA_SIZE, z, ref))
+        {
+          printf("%s, %s schedule: wrong result\n", loops[l].name, sched_name[s]);
+          res = 1;
+        }
+      }
+    }
+  }
+
+  if (cid == 0 && res)
+    exit(res);
+  barrier(&bar, &lbar);
+  exit(0);
+}
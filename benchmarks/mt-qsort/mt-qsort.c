@@ -0,0 +1,153 @@
+// See LICENSE for license details.
+
+//**************************************************************************
+// Multi-threaded sample sort benchmark
+//--------------------------------------------------------------------------
+//
+// This benchmark sorts the qsort benchmark's input by parallel sorting by
+// regular sampling.  Each hart quicksorts its own block of the input (with
+// qsort's sort()) and picks k regular samples from it.  The k*k samples
+// give k-1 splitters, which cut every block into k runs.  Hart j then
+// merges the j'th run of every block into its place in the output.
+//
+// The sort runs on 1, 2, 4, ... harts up to all of them, reporting the
+// speedup of each over one hart, and is checked against qsort's reference
+// output.
+
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "util.h"
+
+//--------------------------------------------------------------------------
+// Input/Reference Data
+
+#define type int
+#include "../qsort/dataset1.h"
+#include "../qsort/qsort.h"
+
+#define MIN(a, b) ((a) < (b) ? (a) : (b))
+
+static type data[DATA_SIZE], out[DATA_SIZE];
+static type samples[MAX_HARTS*MAX_HARTS];
+// run j of hart h's block is data[bound[h][j]] to data[bound[h][j+1]-1]
+static size_t bound[MAX_HARTS][MAX_HARTS+1];
+static barrier_global_data_t bar;
+static size_t cycles[MAX_HARTS];
+
+// the first element of sorted a[0..n-1] greater than x
+static size_t upper_bound(const type* a, size_t n, type x)
+{
+  size_t lo = 0, hi = n;
+  while (lo < hi)
+  {
+    size_t mid = (lo + hi)/2;
+    if (a[mid] <= x)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return lo;
+}
+
+// Sort data into out with harts 0 to k-1; the others only join in the
+// barriers.
+static void sample_sort(int cid, int k, size_t n, barrier_local_data_t* lbar)
+{
+  size_t lo = n*cid/k, len = n*(cid+1)/k - lo;
+
+  if (cid < k)
+  {
+    sort(len, data + lo);
+    for (int j = 0; j < k; j++)
+      samples[cid*k + j] = data[lo + len*j/k];
+  }
+  barrier(&bar, lbar);
+
+  if (cid < k)
+  {
+    // every hart picks the same splitters, the k/2'th sample of each k
+    type all[MAX_HARTS*MAX_HARTS];
+    memcpy(all, samples, k*k*sizeof(type));
+    insertion_sort(k*k, all);
+
+    bound[cid][0] = lo;
+    for (int j = 1; j < k; j++)
+      bound[cid][j] = lo + upper_bound(data + lo, len, all[j*k + k/2 - 1]);
+    bound[cid][k] = lo + len;
+  }
+  barrier(&bar, lbar);
+
+  if (cid < k)
+  {
+    size_t pos = 0;
+    for (int j = 0; j < cid; j++)
+      for (int h = 0; h < k; h++)
+        pos += bound[h][j+1] - bound[h][j];
+
+    size_t head[MAX_HARTS];
+    for (int h = 0; h < k; h++)
+      head[h] = bound[h][cid];
+    for (;;)
+    {
+      int min = -1;
+      for (int h = 0; h < k; h++)
+        if (head[h] < bound[h][cid+1] && (min < 0 || data[head[h]] < data[head[min]]))
+          min = h;
+      if (min < 0)
+        break;
+      out[pos++] = data[head[min]++];
+    }
+  }
+  barrier(&bar, lbar);
+}
+
+// Each hart restores its share of the input
+static void reset(int cid, int nc)
+{
+  size_t lo = DATA_SIZE*cid/nc, hi = DATA_SIZE*(cid+1)/nc;
+  memcpy(data + lo, input_data + lo, (hi - lo)*sizeof(type));
+}
+
+//--------------------------------------------------------------------------
+// Main
+
+void thread_entry(int cid, int nc)
+{
+  barrier_local_data_t lbar = {nc};
+  size_t one = 0;
+  int res = 0;
+
+  setStatsSize(DATA_SIZE);
+  for (int k = 1; ; k = MIN(2*k, nc))
+  {
+    barrier(&bar, &lbar);
+    cycles[cid] = bench_runs("sample_sort", sample_sort(cid, k, DATA_SIZE, &lbar),
+                             DATA_SIZE, BENCH_WARMUP,
+                             reset(cid, nc);
+                             barrier(&bar, &lbar));
+    barrier(&bar, &lbar);
+
+    if (cid == 0)
+    {
+      size_t slowest = 0;
+      for (int h = 0; h < k; h++)
+        slowest = cycles[h] > slowest ? cycles[h] : slowest;
+      one = k == 1 ? slowest : one;
+      printf("%d harts: %d cycles, %d.%02dx\n", k, (int)slowest,
+             (int)(one/slowest), (int)(100*one/slowest%100));
+      if (verify(DATA_SIZE, out, verify_data))
+      {
+        printf("%d harts: wrong result\n", k);
+        res = 1;
+      }
+    }
+    if (k == nc)
+      break;
+  }
+
+  if (cid == 0 && res)
+    exit(res);
+  barrier(&bar, &lbar);
+  exit(0);
+}
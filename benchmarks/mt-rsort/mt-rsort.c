@@ -0,0 +1,233 @@
+// See LICENSE for license details.
+
+//**************************************************************************
+// Multi-threaded radix sort benchmark
+//--------------------------------------------------------------------------
+//
+// LSD radix sort of 32-bit keys, 8 bits per pass.  In each pass every
+// hart counts the digits in its own block of the input.  The harts then
+// turn those counts, together, into the output position of each hart's
+// share of each digit (a parallel prefix sum).  Finally each hart
+// scatters its block into its own disjoint ranges of the output.  On
+// vector cores the counting and scattering use RVV (see vec-rsort.S)
+// unless built with -DSCALAR_RSORT.
+//
+// The keys are generated on target.  Each input size, from MAX_KEYS/64
+// up to MAX_KEYS, is sorted by 1, 2, 4, ... harts up to all of them,
+// with keys/cycle reported for each.
+
+#include <stdint.h>
+#include <string.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "util.h"
+#include "gendata.h"
+
+#ifndef MAX_KEYS
+# define MAX_KEYS 65536
+#endif
+#define NSIZES 4
+#define SEED 1
+
+#define LOG_BASE 8
+#define BASE (1 << LOG_BASE)
+
+#define MIN(a, b) ((a) < (b) ? (a) : (b))
+
+typedef uint32_t type;
+
+static type keys[MAX_KEYS], scratch[MAX_KEYS];
+// each hart's digit counts, then where its keys of each digit go
+static uint32_t hist[MAX_HARTS][BASE] __attribute__((aligned(CACHE_LINE_SIZE)));
+static uint32_t start[MAX_HARTS][BASE] __attribute__((aligned(CACHE_LINE_SIZE)));
+static uint32_t slice_sum[MAX_HARTS];
+static barrier_global_data_t bar;
+static size_t cycles[MAX_HARTS];
+
+#if defined(__riscv_vector) && !defined(SCALAR_RSORT)
+# define RSORT_VECTOR 1
+void rsort_hist_vec(const uint32_t* keys, size_t m, size_t shift, uint32_t* cnt);
+void rsort_scatter_vec(const uint32_t* keys, size_t m, size_t shift,
+                       uint32_t* pos, uint32_t* out);
+
+static size_t rsort_lanes()
+{
+  size_t vlmax;
+  asm volatile ("vsetvli %0, zero, e32, m1, ta, ma" : "=r"(vlmax));
+  return vlmax;
+}
+#else
+static size_t rsort_lanes()
+{
+  return 0;
+}
+#endif
+
+// A hart's block is split into one sub-block per vector lane, then the
+// keys left over (all of them on scalar cores), each with its own
+// counts, which become its output positions.
+typedef struct {
+  size_t lanes;
+  uint32_t* cnt;        // digit d of lane l at cnt[d*lanes + l]
+  uint32_t tail[BASE];
+} counts_t;
+
+static void sort_pass(int cid, int nc, int k, size_t n, const type* in, type* out,
+                      int shift, counts_t* c, barrier_local_data_t* lbar)
+{
+  // harts beyond the k sorting have empty blocks
+  size_t lo = cid < k ? n*cid/k : n, hi = cid < k ? n*(cid+1)/k : n;
+  size_t lanes = c->lanes, m = lanes ? (hi - lo)/lanes : 0;
+  const type* tail = in + lo + m*lanes;
+
+  memset(c->cnt, 0, BASE*lanes*sizeof(uint32_t));
+  memset(c->tail, 0, sizeof(c->tail));
+#if RSORT_VECTOR
+  if (m)
+    rsort_hist_vec(in + lo, m, shift, c->cnt);
+#endif
+  for (const type* p = tail; p < in + hi; p++)
+    c->tail[(*p >> shift) % BASE]++;
+  for (int d = 0; d < BASE; d++)
+  {
+    uint32_t s = c->tail[d];
+    for (size_t l = 0; l < lanes; l++)
+      s += c->cnt[d*lanes + l];
+    hist[cid][d] = s;
+  }
+  barrier(&bar, lbar);
+
+  // Each hart sums its slice of the digits over all harts, in digit then
+  // hart order, and then offsets the sums by the slices before its own.
+  int d0 = BASE*cid/nc, d1 = BASE*(cid+1)/nc;
+  uint32_t sum = 0;
+  for (int d = d0; d < d1; d++)
+  {
+    for (int h = 0; h < nc; h++)
+    {
+      start[h][d] = sum;
+      sum += hist[h][d];
+    }
+  }
+  slice_sum[cid] = sum;
+  barrier(&bar, lbar);
+
+  uint32_t base = 0;
+  for (int h = 0; h < cid; h++)
+    base += slice_sum[h];
+  for (int d = d0; d < d1; d++)
+    for (int h = 0; h < nc; h++)
+      start[h][d] += base;
+  barrier(&bar, lbar);
+
+  for (int d = 0; d < BASE; d++)
+  {
+    uint32_t pos = start[cid][d];
+    for (size_t l = 0; l < lanes; l++)
+    {
+      uint32_t cnt = c->cnt[d*lanes + l];
+      c->cnt[d*lanes + l] = pos;
+      pos += cnt;
+    }
+    c->tail[d] = pos;
+  }
+#if RSORT_VECTOR
+  if (m)
+    rsort_scatter_vec(in + lo, m, shift, c->cnt, out);
+#endif
+  for (const type* p = tail; p < in + hi; p++)
+    out[c->tail[(*p >> shift) % BASE]++] = *p;
+  barrier(&bar, lbar);
+}
+
+// Sort the first n keys with harts 0 to k-1; the others only join in
+// the prefix sums and barriers.
+static void sort(int cid, int nc, int k, size_t n, counts_t* c, barrier_local_data_t* lbar)
+{
+  type *in = keys, *out = scratch;
+  for (int shift = 0; shift < CHAR_BIT * sizeof(type); shift += LOG_BASE)
+  {
+    sort_pass(cid, nc, k, n, in, out, shift, c, lbar);
+    type* tmp = in;
+    in = out;
+    out = tmp;
+  }
+  static_assert(sizeof(type) * CHAR_BIT / LOG_BASE % 2 == 0);
+}
+
+static inline type gen_key(size_t i)
+{
+  return gen_u64(SEED, i) >> 32;
+}
+
+static void fill(int cid, int nc, size_t n)
+{
+  for (size_t i = n*cid/nc; i < n*(cid+1)/nc; i++)
+    keys[i] = gen_key(i);
+}
+
+// The keys must be in order and, by a hash summed over them, still be
+// the generated ones.
+static int check(size_t n)
+{
+  uint64_t want = 0, got = 0;
+  for (size_t i = 0; i < n; i++)
+  {
+    if (i > 0 && keys[i-1] > keys[i])
+      return 1;
+    want += gen_u64(0, gen_key(i));
+    got += gen_u64(0, keys[i]);
+  }
+  return want != got;
+}
+
+//--------------------------------------------------------------------------
+// Main
+
+void thread_entry(int cid, int nc)
+{
+  barrier_local_data_t lbar = {nc};
+  counts_t c;
+  int res = 0;
+
+  c.lanes = rsort_lanes();
+  c.cnt = arena_alloc(BASE*c.lanes*sizeof(uint32_t), CACHE_LINE_SIZE);
+  if (cid == 0)
+    printf("%d vector lanes per hart\n", (int)c.lanes);
+
+  for (int s = NSIZES - 1; s >= 0; s--)
+  {
+    size_t n = MAX_KEYS >> 2*s;
+    for (int k = 1; ; k = MIN(2*k, nc))
+    {
+      barrier(&bar, &lbar);
+      cycles[cid] = bench_runs("sort", sort(cid, nc, k, n, &c, &lbar), n, BENCH_WARMUP,
+                               fill(cid, nc, n);
+                               barrier(&bar, &lbar));
+      barrier(&bar, &lbar);
+
+      if (cid == 0)
+      {
+        size_t slowest = 0;
+        for (int h = 0; h < k; h++)
+          slowest = cycles[h] > slowest ? cycles[h] : slowest;
+        size_t kpc = 1000*n/slowest;
+        printf("%d keys, %d harts: %d.%03d keys/cycle\n", (int)n, k,
+               (int)(kpc/1000), (int)(kpc%1000));
+        if (check(n))
+        {
+          printf("%d keys, %d harts: wrong result\n", (int)n, k);
+          res = 1;
+        }
+      }
+      if (k == nc)
+        break;
+    }
+  }
+
+  if (cid == 0 && res)
+    exit(res);
+  barrier(&bar, &lbar);
+  exit(0);
+}
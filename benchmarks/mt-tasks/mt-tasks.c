@@ -0,0 +1,192 @@
+// See LICENSE for license details.
+
+//**************************************************************************
+// Work-stealing task benchmark
+//--------------------------------------------------------------------------
+//
+// This benchmark runs two recursive workloads on the task runtime in
+// parallel.h: quicksort of the qsort benchmark's input, which spawns the
+// left half of every partition and sorts the right itself, and the
+// doubly recursive Fibonacci, which spawns fib(n-1) and computes
+// fib(n-2) itself.  Both run serially below a cutoff.  Each is timed on
+// hart 0 alone without the runtime, then with all harts, and we report
+// the speedup and how many tasks each hart stole.
+
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include "util.h"
+#include "parallel.h"
+
+//--------------------------------------------------------------------------
+// Input/Reference Data
+
+#define type int
+#include "../qsort/dataset1.h"
+#include "../qsort/qsort.h"
+
+#ifndef QSORT_CUTOFF
+# define QSORT_CUTOFF 64
+#endif
+#ifndef FIB_N
+# define FIB_N 24
+#endif
+#ifndef FIB_CUTOFF
+# define FIB_CUTOFF 12
+#endif
+
+static type data[DATA_SIZE];
+
+//--------------------------------------------------------------------------
+// Quicksort
+
+typedef struct {
+  type* a;
+  size_t n;
+} range_t;
+
+static void psort(void* arg)
+{
+  range_t* r = arg;
+  type* a = r->a;
+  size_t n = r->n;
+
+  if (n <= QSORT_CUTOFF)
+  {
+    sort(n, a);
+    return;
+  }
+
+  // Hoare partition: a[0..j] <= p <= a[j+1..n-1], both sides nonempty
+  type p = a[(n-1)/2];
+  size_t i = -1, j = n;
+  for (;;)
+  {
+    while (a[++i] < p)
+      ;
+    while (a[--j] > p)
+      ;
+    if (i >= j)
+      break;
+    SWAP(a[i], a[j]);
+  }
+
+  range_t left = {a, j+1}, right = {a+j+1, n-j-1};
+  task_t t;
+  task_spawn(&t, psort, &left);
+  psort(&right);
+  task_sync(&t);
+}
+
+static void reset()
+{
+  memcpy(data, input_data, sizeof(data));
+}
+
+//--------------------------------------------------------------------------
+// Fibonacci
+
+typedef struct {
+  int n;
+  long r;
+} fib_t;
+
+static long fib(int n)
+{
+  return n < 2 ? n : fib(n-1) + fib(n-2);
+}
+
+static void pfib(void* arg)
+{
+  fib_t* f = arg;
+
+  if (f->n < FIB_CUTOFF)
+  {
+    f->r = fib(f->n);
+    return;
+  }
+
+  fib_t a = {f->n-1}, b = {f->n-2};
+  task_t t;
+  task_spawn(&t, pfib, &a);
+  pfib(&b);
+  task_sync(&t);
+  f->r = a.r + b.r;
+}
+
+//--------------------------------------------------------------------------
+// Main
+
+static barrier_global_data_t bar;
+static size_t cycles[MAX_HARTS], steals[MAX_HARTS];
+
+static void report(const char* name, size_t serial, int nc)
+{
+  size_t slowest = 0, total = 0;
+  for (int h = 0; h < nc; h++)
+  {
+    slowest = cycles[h] > slowest ? cycles[h] : slowest;
+    total += steals[h];
+  }
+  printf("%s: %d cycles on 1 hart, %d cycles on %d harts, %d.%02dx, %d steals:",
+         name, (int)serial, (int)slowest, nc,
+         (int)(serial/slowest), (int)(100*serial/slowest%100), (int)total);
+  for (int h = 0; h < nc; h++)
+    printf(" %d", (int)steals[h]);
+  printf("\n");
+}
+
+void thread_entry(int cid, int nc)
+{
+  barrier_local_data_t lbar = {nc};
+  size_t serial = 0;
+  int res = 0;
+
+  range_t all = {data, DATA_SIZE};
+  if (cid == 0)
+  {
+    serial = bench_runs("sort", sort(DATA_SIZE, data), DATA_SIZE, BENCH_WARMUP, reset());
+    res |= verify(DATA_SIZE, data, verify_data) != 0;
+  }
+  barrier(&bar, &lbar);
+  cycles[cid] = bench_runs("psort", task_run(psort, &all), DATA_SIZE, BENCH_WARMUP,
+                           if (cid == 0) reset();
+                           barrier(&bar, &lbar));
+  steals[cid] = task_steals();
+  barrier(&bar, &lbar);
+  if (cid == 0)
+  {
+    report("quicksort", serial, nc);
+    if (verify(DATA_SIZE, data, verify_data))
+    {
+      printf("quicksort: wrong result\n");
+      res = 1;
+    }
+  }
+
+  // volatile, so that fib(n) is recomputed on every run
+  static volatile int n = FIB_N;
+  static fib_t f = {FIB_N};
+  long want = 0;
+  if (cid == 0)
+    serial = bench_runs("fib", want = fib(n), 1, BENCH_WARMUP, );
+  barrier(&bar, &lbar);
+  cycles[cid] = bench_runs("pfib", task_run(pfib, &f), 1, BENCH_WARMUP,
+                           barrier(&bar, &lbar));
+  steals[cid] = task_steals();
+  barrier(&bar, &lbar);
+  if (cid == 0)
+  {
+    report("fib", serial, nc);
+    if (f.r != want)
+    {
+      printf("fib: wrong result\n");
+      res = 1;
+    }
+  }
+
+  if (cid == 0 && res)
+    exit(res);
+  barrier(&bar, &lbar);
+  exit(0);
+}
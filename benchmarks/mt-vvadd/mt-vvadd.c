@@ -8,9 +8,12 @@
 // Student : 
 //
 // This benchmark adds two vectors and writes the results to a
-// third vector. The input data (and reference data) should be
-// generated using the vvadd_gendata.pl perl script and dumped
-// to a file named dataset.h 
+// third vector. The input data (and the digest of the expected
+// results) should be generated using the vvadd_gendata.pl perl script
+// and dumped to a file named dataset.h. Alternatively, building with
+// -DDATA_SIZE=n has the threads generate n-element inputs at startup;
+// hart 0 then recomputes the expected digest unless -DVERIFY_DIGEST
+// gives it.
 
 //--------------------------------------------------------------------------
 // Includes 
@@ -23,7 +26,17 @@
 //--------------------------------------------------------------------------
 // Input/Reference Data
 
+#ifdef DATA_SIZE
+#include "gendata.h"
+#define GEN_DATA 1
+#define SEED1 1
+#define SEED2 2
+typedef double data_t;
+static data_t input1_data[DATA_SIZE];
+static data_t input2_data[DATA_SIZE];
+#else
 #include "dataset.h"
+#endif
  
   
 //--------------------------------------------------------------------------
@@ -50,13 +63,28 @@ void thread_entry(int cid, int nc)
    // static allocates data in the binary, which is visible to both threads
    static data_t results_data[DATA_SIZE];
    barrier_local_data_t lbar = {nc};
+
+#if GEN_DATA
+   size_t begin = DATA_SIZE * cid / nc, end = DATA_SIZE * (cid + 1) / nc;
+   gen_double(input1_data, begin, end, SEED1, 19);
+   gen_double(input2_data, begin, end, SEED2, 19);
+#endif
+
+#ifndef VERIFY_DIGEST
+   uint64_t digest = DIGEST_INIT;
+   if(cid == 0) {
+     for (size_t i = 0; i < DATA_SIZE; i++)
+       digest = digest_double1(digest, (double)gen_range(SEED1, i, 19) + gen_range(SEED2, i, 19));
+   }
+# define VERIFY_DIGEST digest
+#endif
    
    // First do out-of-place vvadd
    barrier(&bar, &lbar);
-   stats(vvadd(cid, nc, DATA_SIZE, input1_data, input2_data, results_data); barrier(&bar, &lbar), DATA_SIZE);
+   stats(vvadd(cid, nc, DATA_SIZE, input1_data, input2_data, results_data), DATA_SIZE);
  
    if(cid == 0) {
-     int res = verifyDouble(DATA_SIZE, results_data, verify_data);
+     int res = verifyDoubleDigest(DATA_SIZE, results_data, VERIFY_DIGEST);
      if(res) exit(res);
    }
 
@@ -68,10 +96,10 @@ void thread_entry(int cid, int nc)
            results_data[i] = input1_data[i];
    }
    barrier(&bar, &lbar);
-   stats(vvadd(cid, nc, DATA_SIZE, results_data, input2_data, results_data); barrier(&bar, &lbar), DATA_SIZE);
+   stats(vvadd(cid, nc, DATA_SIZE, results_data, input2_data, results_data), DATA_SIZE);
  
    if(cid == 0) {
-     int res = verifyDouble(DATA_SIZE, results_data, verify_data);
+     int res = verifyDoubleDigest(DATA_SIZE, results_data, VERIFY_DIGEST);
      if(res) exit(res);
    }
    
@@ -1,7 +1,12 @@
 // See LICENSE for license details.
 
 #include "stdlib.h"
+
+#ifdef DATA_SIZE
+typedef double data_t;
+#else
 #include "dataset.h"
+#endif
 
 //--------------------------------------------------------------------------
 // vvadd function
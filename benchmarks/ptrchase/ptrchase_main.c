@@ -0,0 +1,215 @@
+// See LICENSE for license details.
+
+//**************************************************************************
+// Pointer-chasing memory latency benchmark
+//--------------------------------------------------------------------------
+//
+// This benchmark follows a chain of pointers through a random cyclic
+// permutation of the cache lines of a working set.  Every load depends on
+// the one before it and lands on a line the core cannot predict.  The
+// working set doubles from CHASE_MIN to CHASE_MAX bytes, and cycles/load
+// traces out the load-to-use latency of each level of the memory
+// hierarchy.  Following 2, 4 and 8 chains through the same cycle at
+// once, from evenly spaced starting points, shows how many misses the
+// core keeps in flight.  The rings are shuffled on target, so slow
+// targets may want a smaller CHASE_MAX.
+
+#include <stdint.h>
+#include <stdio.h>
+#include "util.h"
+
+#ifndef CHASE_MIN
+# define CHASE_MIN (1 << 10)
+#endif
+#ifndef CHASE_MAX
+# define CHASE_MAX (64 << 20)
+#endif
+// loads per timed run, whatever the number of chains; each run carries
+// on from where the last stopped
+#ifndef CHASE_LOADS
+# define CHASE_LOADS (1 << 16)
+#endif
+#define NSIZES 32
+#define MAX_CHAINS 8
+#define NCHAINS 4
+
+static const int chains[NCHAINS] = {1, 2, 4, 8};
+static const char* chains_name[NCHAINS] = {"1 chain", "2 chains", "4 chains", "8 chains"};
+
+// One node per cache line.  While the ring is built, idx holds the
+// number of the next node; then next points to it.
+typedef union node {
+  union node* next;
+  uintptr_t idx;
+  char line[CACHE_LINE_SIZE];
+} node_t;
+
+static node_t mem[CHASE_MAX/sizeof(node_t)];
+
+static uint64_t seed = 1;
+
+static size_t random_below(size_t n)
+{
+  // step past the bits the last number used
+  for (int i = 0; i < 32; i++)
+    seed = lfsr(seed);
+  return seed % n;
+}
+
+// Sattolo's shuffle: a random permutation that is a single cycle
+static void build_ring(size_t n)
+{
+  for (size_t i = 0; i < n; i++)
+    mem[i].idx = i;
+  for (size_t i = n - 1; i > 0; i--)
+  {
+    size_t j = random_below(i);
+    uintptr_t t = mem[i].idx;
+    mem[i].idx = mem[j].idx;
+    mem[j].idx = t;
+  }
+  for (size_t i = 0; i < n; i++)
+    mem[i].next = &mem[mem[i].idx];
+}
+
+static int not_one_cycle(size_t n)
+{
+  node_t* p = &mem[0];
+  for (size_t i = 1; i < n; i++)
+    if ((p = p->next) == &mem[0])
+      return 1;
+  return p->next != &mem[0];
+}
+
+// Take steps steps along each of the k chains from pos[], and leave them
+// where they stop, so that the next run carries on into lines this one
+// has not touched.
+static void chase(node_t* volatile* pos, int k, size_t steps)
+{
+  switch (k)
+  {
+    case 1:
+    {
+      node_t* p0 = pos[0];
+      for (size_t i = 0; i < steps; i++)
+        p0 = p0->next;
+      pos[0] = p0;
+      break;
+    }
+    case 2:
+    {
+      node_t *p0 = pos[0], *p1 = pos[1];
+      for (size_t i = 0; i < steps; i++)
+      {
+        p0 = p0->next;
+        p1 = p1->next;
+      }
+      pos[0] = p0;
+      pos[1] = p1;
+      break;
+    }
+    case 4:
+    {
+      node_t *p0 = pos[0], *p1 = pos[1], *p2 = pos[2], *p3 = pos[3];
+      for (size_t i = 0; i < steps; i++)
+      {
+        p0 = p0->next;
+        p1 = p1->next;
+        p2 = p2->next;
+        p3 = p3->next;
+      }
+      pos[0] = p0;
+      pos[1] = p1;
+      pos[2] = p2;
+      pos[3] = p3;
+      break;
+    }
+    case 8:
+    {
+      node_t *p0 = pos[0], *p1 = pos[1], *p2 = pos[2], *p3 = pos[3];
+      node_t *p4 = pos[4], *p5 = pos[5], *p6 = pos[6], *p7 = pos[7];
+      for (size_t i = 0; i < steps; i++)
+      {
+        p0 = p0->next;
+        p1 = p1->next;
+        p2 = p2->next;
+        p3 = p3->next;
+        p4 = p4->next;
+        p5 = p5->next;
+        p6 = p6->next;
+        p7 = p7->next;
+      }
+      pos[0] = p0;
+      pos[1] = p1;
+      pos[2] = p2;
+      pos[3] = p3;
+      pos[4] = p4;
+      pos[5] = p5;
+      pos[6] = p6;
+      pos[7] = p7;
+      break;
+    }
+  }
+}
+
+static void print_cpl(size_t cpl)
+{
+  printf("%6d.%02d", (int)(cpl/100), (int)(cpl%100));
+}
+
+//--------------------------------------------------------------------------
+// Main
+
+int main( int argc, char* argv[] )
+{
+  // cycles/load in hundredths, by size and number of chains
+  static size_t result[NSIZES][NCHAINS];
+  int nsizes = 0;
+
+  for (size_t size = CHASE_MIN; size <= CHASE_MAX && nsizes < NSIZES; size *= 2, nsizes++)
+  {
+    size_t n = size/sizeof(node_t);
+    build_ring(n);
+    if (not_one_cycle(n))
+      return 1;
+
+    // MAX_CHAINS starting points spread evenly around the cycle
+    node_t* start[MAX_CHAINS];
+    node_t* p = &mem[0];
+    for (size_t i = 0, j = 0; j < MAX_CHAINS; i++, p = p->next)
+      if (i == j*n/MAX_CHAINS)
+        start[j++] = p;
+
+    for (int c = 0; c < NCHAINS; c++)
+    {
+      int k = chains[c];
+      size_t steps = CHASE_LOADS/k;
+      node_t* volatile s[MAX_CHAINS];
+      for (int j = 0; j < k; j++)
+        s[j] = start[j*MAX_CHAINS/k];
+
+      size_t cycles = bench_runs(chains_name[c], chase(s, k, steps), steps*k,
+                                 BENCH_WARMUP, );
+      result[nsizes][c] = 100*cycles/(steps*k);
+    }
+
+    printf("%d KB:", (int)(size >> 10));
+    for (int c = 0; c < NCHAINS; c++)
+      print_cpl(result[nsizes][c]);
+    printf(" cycles/load\n");
+  }
+
+  printf("cycles/load ");
+  for (int c = 0; c < NCHAINS; c++)
+    printf(" %8s", chains_name[c]);
+  printf("\n");
+  for (int s = 0; s < nsizes; s++)
+  {
+    printf("%8d KB  ", (int)((size_t)CHASE_MIN << s >> 10));
+    for (int c = 0; c < NCHAINS; c++)
+      print_cpl(result[s][c]);
+    printf("\n");
+  }
+
+  return 0;
+}
@@ -0,0 +1,75 @@
+#!/usr/bin/python3
+
+"""Collect the result records printed at exit by each benchmark (one JSON
+object per hart per line) from a set of .riscv.out files into a single CSV
+and/or JSON table."""
+
+import argparse
+import csv
+import json
+import os
+import sys
+
+FIXED_COLUMNS = ["tag", "benchmark", "hart", "harts", "size", "verify",
+                 "exit_code"]
+
+def read_records(path):
+    records = []
+    with open(path) as f:
+        for line in f:
+            line = line.strip()
+            if not line.startswith("{"):
+                continue
+            try:
+                record = json.loads(line)
+            except ValueError:
+                continue
+            if isinstance(record, dict) and "benchmark" in record:
+                records.append(record)
+    if not records:
+        # Crashed, timed out, or built without the record support.
+        name = os.path.basename(path).split(".riscv")[0]
+        records.append({"benchmark": name, "verify": "no record"})
+    return records
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("outputs", nargs="*", help=".riscv.out files")
+    parser.add_argument("--tag", default="",
+                        help="label for every row, e.g. the hardware revision")
+    parser.add_argument("--csv", help="write the table here as CSV")
+    parser.add_argument("--json", help="write the table here as JSON")
+    args = parser.parse_args()
+
+    rows = []
+    for path in args.outputs:
+        for record in read_records(path):
+            record["tag"] = args.tag
+            rows.append(record)
+
+    # Counters differ between builds (HPM_EVENTS), so they follow the fixed
+    # columns in order of first appearance.
+    columns = list(FIXED_COLUMNS)
+    for row in rows:
+        for key in row:
+            if key not in columns:
+                columns.append(key)
+
+    if args.json:
+        with open(args.json, "w") as f:
+            json.dump(rows, f, indent=2)
+            f.write("\n")
+
+    out = open(args.csv, "w", newline="") if args.csv else sys.stdout
+    writer = csv.DictWriter(out, fieldnames=columns)
+    writer.writeheader()
+    writer.writerows(rows)
+    if out is not sys.stdout:
+        out.close()
+
+    failed = [r["benchmark"] for r in rows if r.get("verify") != "pass"]
+    if failed:
+        sys.stderr.write("not passing: %s\n" % " ".join(sorted(set(failed))))
+
+if __name__ == "__main__":
+    sys.exit(main())
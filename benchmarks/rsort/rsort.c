@@ -113,6 +113,7 @@ int main( int argc, char* argv[] )
 #endif
 
   // Do the sort
+  setStatsSize(DATA_SIZE);
   setStats(1);
   sort(DATA_SIZE, input_data, scratch);
   setStats(0);
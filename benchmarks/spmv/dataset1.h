@@ -5808,505 +5808,4 @@ const int ptr[501] = {
   2394,
   2399
 };
-const double verify_data[500] = {
-  1636962,
-  1714376,
-  142636,
-  1151015,
-  1672341,
-  2790420,
-  1447201,
-  422892,
-  30953,
-  1030287,
-  1335188,
-  0,
-  605334,
-  2278445,
-  858848,
-  245423,
-  950882,
-  705076,
-  1312024,
-  1084284,
-  1837558,
-  1201746,
-  2360392,
-  1488940,
-  688178,
-  2632122,
-  1481444,
-  660854,
-  346453,
-  982949,
-  1400599,
-  1093225,
-  2856372,
-  1078398,
-  1074402,
-  579548,
-  1820752,
-  2638601,
-  2072665,
-  749887,
-  687788,
-  478788,
-  1482258,
-  1207317,
-  1397243,
-  794364,
-  1002505,
-  1651686,
-  1028801,
-  1189726,
-  1513197,
-  1214956,
-  738475,
-  633771,
-  1207042,
-  680857,
-  899314,
-  2277406,
-  773143,
-  1986687,
-  907216,
-  907940,
-  1539019,
-  1043338,
-  681730,
-  219905,
-  1397298,
-  2184201,
-  1537202,
-  266744,
-  563005,
-  1827909,
-  1105928,
-  2286680,
-  887533,
-  343193,
-  238910,
-  1678393,
-  2600003,
-  417502,
-  1551071,
-  798273,
-  398719,
-  2056881,
-  1296314,
-  917292,
-  190534,
-  882078,
-  1979139,
-  50621,
-  1048185,
-  1967771,
-  1911887,
-  1895897,
-  23343,
-  2658748,
-  285864,
-  1027049,
-  975769,
-  2488413,
-  832738,
-  844130,
-  1379856,
-  1785889,
-  2463463,
-  782430,
-  982466,
-  609500,
-  706251,
-  1981399,
-  1861430,
-  2146667,
-  250104,
-  1166284,
-  1295022,
-  189599,
-  855191,
-  1005718,
-  969658,
-  707377,
-  561273,
-  86496,
-  717937,
-  97767,
-  1893638,
-  779229,
-  429727,
-  99564,
-  1863565,
-  2267656,
-  950026,
-  780700,
-  581248,
-  393282,
-  2134865,
-  1244700,
-  1894843,
-  954212,
-  1439102,
-  779512,
-  1459287,
-  881497,
-  2202043,
-  1447401,
-  1249637,
-  765168,
-  488244,
-  837127,
-  1236555,
-  2281259,
-  1995666,
-  25783,
-  534020,
-  1486259,
-  1268571,
-  875283,
-  744594,
-  1410335,
-  757320,
-  0,
-  1922627,
-  399058,
-  1490594,
-  1475527,
-  1587557,
-  1695667,
-  644546,
-  536038,
-  224304,
-  414120,
-  2029077,
-  3930385,
-  377416,
-  1059074,
-  1960417,
-  1439575,
-  368749,
-  460183,
-  2479302,
-  105204,
-  1426355,
-  649313,
-  2194338,
-  918200,
-  1591449,
-  2229266,
-  434520,
-  684504,
-  1009270,
-  222922,
-  600674,
-  1011867,
-  1321434,
-  836127,
-  2493805,
-  1448674,
-  1269364,
-  1304961,
-  98554,
-  2423810,
-  1570229,
-  302458,
-  2806045,
-  1534004,
-  1463827,
-  1085011,
-  120989,
-  1701753,
-  110302,
-  938429,
-  1186733,
-  2255246,
-  425960,
-  376311,
-  341394,
-  1061333,
-  2025091,
-  522270,
-  598604,
-  1000824,
-  2254049,
-  1857539,
-  346425,
-  1345187,
-  550497,
-  1251096,
-  943720,
-  681558,
-  555972,
-  779590,
-  299796,
-  1445763,
-  459865,
-  774572,
-  489448,
-  2407693,
-  1574903,
-  1630452,
-  1907397,
-  555045,
-  1902494,
-  1172223,
-  142555,
-  445864,
-  1376151,
-  1200389,
-  327553,
-  1548402,
-  1106503,
-  888650,
-  41081,
-  1245270,
-  845610,
-  1232215,
-  387441,
-  434475,
-  1204003,
-  1333189,
-  1672468,
-  567827,
-  11392,
-  631046,
-  1299298,
-  719608,
-  714169,
-  362247,
-  1308257,
-  530903,
-  398202,
-  885445,
-  2606806,
-  1354354,
-  438760,
-  194928,
-  712863,
-  1010340,
-  2245646,
-  376041,
-  876890,
-  1683404,
-  955032,
-  1065455,
-  925034,
-  1731713,
-  1152271,
-  2093865,
-  1221433,
-  629438,
-  2054936,
-  2643313,
-  1322567,
-  1492288,
-  1844514,
-  1802382,
-  871,
-  1350044,
-  967406,
-  756881,
-  574442,
-  1295864,
-  1815978,
-  2822668,
-  2201377,
-  2729436,
-  616018,
-  2318346,
-  332717,
-  289665,
-  97812,
-  1881483,
-  1003188,
-  702530,
-  409314,
-  645118,
-  3645947,
-  723792,
-  503126,
-  1609036,
-  1647277,
-  587437,
-  735899,
-  666552,
-  27354,
-  1045106,
-  397951,
-  1087090,
-  1173872,
-  1629962,
-  1334261,
-  1855668,
-  2856970,
-  1341188,
-  336968,
-  0,
-  521349,
-  53118,
-  881926,
-  154917,
-  942966,
-  1237636,
-  820836,
-  579583,
-  1436861,
-  2025006,
-  634434,
-  829152,
-  298073,
-  205380,
-  1622350,
-  1171051,
-  848451,
-  2417009,
-  2016092,
-  390510,
-  2721874,
-  359761,
-  309038,
-  1061522,
-  297026,
-  1311767,
-  305305,
-  854945,
-  1773244,
-  2656339,
-  896058,
-  1069160,
-  1552917,
-  1421821,
-  440874,
-  216699,
-  1654864,
-  521705,
-  807422,
-  1242602,
-  1329872,
-  308130,
-  526463,
-  27937,
-  1450630,
-  1621987,
-  799154,
-  1378289,
-  2519996,
-  1149046,
-  579937,
-  1841561,
-  1895047,
-  1009234,
-  1922198,
-  2570006,
-  409696,
-  442495,
-  277484,
-  979605,
-  1392287,
-  1023715,
-  1881778,
-  2432703,
-  2297384,
-  542451,
-  1368100,
-  833048,
-  1038108,
-  742376,
-  1542317,
-  2230186,
-  1249077,
-  884020,
-  1286059,
-  1102407,
-  1651393,
-  1787846,
-  1370154,
-  2734166,
-  2935249,
-  447485,
-  736859,
-  828966,
-  1547038,
-  765990,
-  1427773,
-  255456,
-  134871,
-  1597546,
-  2173052,
-  1187286,
-  2364828,
-  1220233,
-  1760369,
-  75080,
-  2799969,
-  1363310,
-  2347168,
-  272279,
-  33698,
-  1192053,
-  342501,
-  356092,
-  136578,
-  1701048,
-  2216796,
-  1340150,
-  1852854,
-  580862,
-  407410,
-  1860346,
-  200649,
-  954363,
-  955621,
-  2234154,
-  2007706,
-  646339,
-  2712491,
-  1259244,
-  2368138,
-  1550431,
-  1160903,
-  987838,
-  650293,
-  833228,
-  368144,
-  1998925,
-  1733716,
-  1050000,
-  1061635,
-  1144649,
-  1260205,
-  851043,
-  1417512,
-  2826918,
-  1059350,
-  1522135,
-  1039943,
-  703837,
-  1035006,
-  19505,
-  211545,
-  1461101,
-  1238659,
-  1414306,
-  1151385,
-  2169011,
-  1101116,
-  1118290,
-  335296,
-  1502266,
-  1405699,
-  1762457,
-  530338,
-  246108,
-  484583,
-  2164048,
-  1614511,
-  0,
-  1446940,
-  575450,
-  2043329,
-  2057251,
-  774670,
-  1084124
-};
+#define VERIFY_DIGEST 0x047568c8ff022b8bULL
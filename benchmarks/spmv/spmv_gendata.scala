@@ -38,6 +38,14 @@ def spmv(p: Seq[Int], d: Seq[Int], idx: Seq[Int], v: Seq[Int]) = {
   y
 }
 
+// CRC-64 of y, one 64-bit word per element, matching digest_u64() in
+// common/util.h
+def digest(y: Seq[Int]) = y.foldLeft(~0L) { (crc, yi) =>
+  (0 until 64).foldLeft(crc ^ java.lang.Double.doubleToRawLongBits(yi)) {
+    (c, _) => if (c < 0) (c << 1) ^ 0x42f0e1eba9ea3693L else c << 1
+  }
+}
+
 println("#define R " + m)
 println("#define C " + n)
 println("#define NNZ " + nnz)
@@ -45,4 +53,4 @@ printVec("double", "val", d)
 printVec("int", "idx", idx)
 printVec("double", "x", v)
 printVec("int", "ptr", p)
-printVec("double", "verify_data", spmv(p, d, idx, v))
+println("#define VERIFY_DIGEST 0x%016xULL".format(digest(spmv(p, d, idx, v))))
@@ -3,13 +3,96 @@
 //**************************************************************************
 // Double-precision sparse matrix-vector multiplication benchmark
 //--------------------------------------------------------------------------
+//
+// The CSR matrix is split across the harts by rows, balanced by nonzeros.
+// Each hart also converts its rows to ELL and SELL-C-sigma and times all
+// three formats, which use RVV gathers when built for a vector core (see
+// vec-spmv.S) unless built with -DSCALAR_SPMV.  Each format reports
+// GFLOP/s and bytes/cycle, the bytes being its matrix, row metadata and
+// y plus one read of x.
 
+#include <stdint.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
 #include "util.h"
 
 //--------------------------------------------------------------------------
 // Input/Reference Data
+//
+// Building with -DR=rows (and optionally -DC=cols and -DNNZ=nonzeros)
+// generates the matrix at startup instead of using dataset1.h.  The
+// expected digest of y is then recomputed on target unless
+// -DVERIFY_DIGEST gives it.
 
+#ifdef R
+#include "gendata.h"
+#define GEN_DATA 1
+#ifndef C
+# define C R
+#endif
+#ifndef NNZ
+# define NNZ (5*R)
+#endif
+#define SEED_VAL 1
+#define SEED_IDX 2
+#define SEED_X 3
+
+double val[NNZ];
+int idx[NNZ];
+double x[C];
+int ptr[R+1];
+
+// Row i holds NNZ/R nonzeros, plus one for the first NNZ%R rows, with
+// the k'th of its n nonzeros placed at random in the k'th of n equal
+// slices of the row, so columns come out sorted and distinct.
+static inline int gen_row_nnz(int i)
+{
+  return NNZ/R + (i < NNZ%R);
+}
+
+static inline int gen_col(int p, int k, int n)
+{
+  int lo = (long)k*C/n, hi = (long)(k+1)*C/n;
+  return lo + gen_range(SEED_IDX, p, hi - lo);
+}
+
+static void gen_matrix()
+{
+  static_assert(NNZ/R < C);
+
+  gen_double(x, 0, C, SEED_X, 1000);
+  ptr[0] = 0;
+  for (int i = 0; i < R; i++) {
+    int n = gen_row_nnz(i);
+    ptr[i+1] = ptr[i] + n;
+    for (int k = 0; k < n; k++) {
+      int p = ptr[i] + k;
+      idx[p] = gen_col(p, k, n);
+      val[p] = gen_range(SEED_VAL, p, 1000);
+    }
+  }
+}
+
+// The expected digest comes straight from the generator, not the arrays.
+// All values are small integers, so every sum is exact in any order.
+static uint64_t gen_verify_digest()
+{
+  uint64_t h = DIGEST_INIT;
+  for (int i = 0, p = 0; i < R; i++) {
+    int n = gen_row_nnz(i);
+    double yi = 0;
+    for (int k = 0; k < n; k++, p++)
+      yi += (double)gen_range(SEED_VAL, p, 1000) * gen_range(SEED_X, gen_col(p, k, n), 1000);
+    h = digest_double1(h, yi);
+  }
+  return h;
+}
+#else
 #include "dataset1.h"
+#endif
+
+#define MIN(a, b) ((a) < (b) ? (a) : (b))
 
 void spmv(int r, const double* val, const int* idx, const double* x,
           const int* ptr, double* y)
@@ -33,20 +116,356 @@ void spmv(int r, const double* val, const int* idx, const double* x,
   }
 }
 
+//--------------------------------------------------------------------------
+// ELL and SELL-C-sigma
+//
+// ELL pads every row to the longest one and stores the matrix column by
+// column, so consecutive rows are consecutive in memory.  SELL-C-sigma
+// does the same for chunks of c rows, each padded only to its own longest
+// row, after sorting the rows of each window of sigma rows by length so
+// that rows of a chunk are alike.  Both store column indices as byte
+// offsets into x, as the vector gathers take them.
+
+#ifndef SELL_C
+# define SELL_C 8
+#endif
+#ifndef SELL_SIGMA
+# define SELL_SIGMA 64
+#endif
+
+typedef struct {
+  size_t r, w;          // rows, padded row length
+  double* val;          // entry k of row i at val[k*r + i]
+  uint32_t* off;        // and its column's byte offset in x at off[k*r + i]
+} ell_t;
+
+typedef struct {
+  size_t r, c, nchunks;
+  uint32_t* cl;         // padded row length of each chunk
+  double* val;          // entry k of lane l at val[k*c + l] from the
+  uint32_t* off;        // chunk's start, chunks one after another
+  uint32_t* perm;       // byte offset in y of the row in each lane
+} sell_t;
+
+void spmv_ell_scalar(size_t r, size_t w, const double* val,
+                     const uint32_t* off, const double* x, double* y)
+{
+  for (size_t i = 0; i < r; i++)
+  {
+    double yi = 0;
+    for (size_t k = 0; k < w; k++)
+      yi += val[k*r+i] * *(const double*)((const char*)x + off[k*r+i]);
+    y[i] = yi;
+  }
+}
+
+void spmv_sell_scalar(size_t r, size_t c, const uint32_t* cl,
+                      const double* val, const uint32_t* off,
+                      const uint32_t* perm, const double* x, double* y)
+{
+  for (size_t j = 0; j < r; j += c, cl++, perm += c)
+  {
+    size_t lanes = MIN(c, r - j);
+    for (size_t l = 0; l < lanes; l++)
+    {
+      double yi = 0;
+      for (size_t k = 0; k < *cl; k++)
+        yi += val[k*c+l] * *(const double*)((const char*)x + off[k*c+l]);
+      *(double*)((char*)y + perm[l]) = yi;
+    }
+    val += *cl * c;
+    off += *cl * c;
+  }
+}
+
+#if defined(__riscv_vector) && !defined(SCALAR_SPMV)
+void spmv_ell_vec(size_t r, size_t w, const double* val,
+                  const uint32_t* off, const double* x, double* y);
+void spmv_sell_vec(size_t r, size_t c, const uint32_t* cl,
+                   const double* val, const uint32_t* off,
+                   const uint32_t* perm, const double* x, double* y);
+# define SPMV_IMPL(name) name##_vec
+
+// A chunk is one vector of doubles at LMUL=4, as spmv_sell_vec uses
+static size_t sell_lanes()
+{
+  size_t vlmax;
+  asm volatile ("vsetvli %0, zero, e64, m4, ta, ma" : "=r"(vlmax));
+  return vlmax;
+}
+#else
+# define SPMV_IMPL(name) name##_scalar
+
+static size_t sell_lanes()
+{
+  return SELL_C;
+}
+#endif
+
+static inline int row_nnz(int i)
+{
+  return ptr[i+1] - ptr[i];
+}
+
+static void to_ell(ell_t* e, int r0, int r1)
+{
+  size_t r = r1 - r0, w = 0;
+  for (int i = r0; i < r1; i++)
+    w = row_nnz(i) > w ? row_nnz(i) : w;
+
+  e->r = r;
+  e->w = w;
+  e->val = arena_alloc(r*w*sizeof(double), CACHE_LINE_SIZE);
+  e->off = arena_alloc(r*w*sizeof(uint32_t), CACHE_LINE_SIZE);
+  for (size_t i = 0; i < r; i++)
+  {
+    for (size_t k = 0; k < w; k++)
+    {
+      int n = row_nnz(r0+i), p = ptr[r0+i] + k;
+      e->val[k*r+i] = k < n ? val[p] : 0;
+      e->off[k*r+i] = k < n ? idx[p]*sizeof(double) : 0;
+    }
+  }
+}
+
+static void to_sell(sell_t* s, int r0, int r1)
+{
+  size_t r = r1 - r0, c = sell_lanes(), nchunks = (r + c - 1)/c;
+  size_t sigma = (SELL_SIGMA + c - 1)/c*c;
+
+  s->r = r;
+  s->c = c;
+  s->nchunks = nchunks;
+  s->cl = arena_alloc(nchunks*sizeof(uint32_t), sizeof(uint32_t));
+  s->perm = arena_alloc(nchunks*c*sizeof(uint32_t), CACHE_LINE_SIZE);
+
+  // perm holds row numbers until the end: each window of sigma rows in
+  // descending order of length, ties in row order, then unused lanes
+  uint32_t* rows = s->perm;
+  for (size_t i = 0; i < nchunks*c; i++)
+    rows[i] = i < r ? r0 + i : r0;
+  for (size_t w = 0; w < r; w += sigma)
+  {
+    for (size_t i = w + 1; i < MIN(w + sigma, r); i++)
+    {
+      uint32_t row = rows[i];
+      size_t j;
+      for (j = i; j > w && row_nnz(rows[j-1]) < row_nnz(row); j--)
+        rows[j] = rows[j-1];
+      rows[j] = row;
+    }
+  }
+
+  size_t entries = 0;
+  for (size_t j = 0; j < nchunks; j++)
+  {
+    uint32_t w = 0;
+    for (size_t l = 0; l < c && j*c + l < r; l++)
+      w = row_nnz(rows[j*c+l]) > w ? row_nnz(rows[j*c+l]) : w;
+    s->cl[j] = w;
+    entries += w*c;
+  }
+
+  s->val = arena_alloc(entries*sizeof(double), CACHE_LINE_SIZE);
+  s->off = arena_alloc(entries*sizeof(uint32_t), CACHE_LINE_SIZE);
+  double* v = s->val;
+  uint32_t* o = s->off;
+  for (size_t j = 0; j < nchunks; j++)
+  {
+    for (int k = 0; k < s->cl[j]; k++)
+    {
+      for (size_t l = 0; l < c; l++, v++, o++)
+      {
+        int row = rows[j*c+l], p = ptr[row] + k;
+        int used = j*c + l < r && k < row_nnz(row);
+        *v = used ? val[p] : 0;
+        *o = used ? idx[p]*sizeof(double) : 0;
+      }
+    }
+  }
+
+  for (size_t i = 0; i < nchunks*c; i++)
+    s->perm[i] = rows[i]*sizeof(double);
+}
+
 //--------------------------------------------------------------------------
 // Main
 
-int main( int argc, char* argv[] )
+enum { CSR, ELL, SELL, NFORMATS };
+static const char* format_name[NFORMATS] = {"csr", "ell", "sell"};
+static const char* cold_name[NFORMATS] = {"csr (cold)", "ell (cold)", "sell (cold)"};
+
+typedef struct {
+  int r0, r1;           // this hart's rows
+  ell_t ell;
+  sell_t sell;
+} part_t;
+
+static barrier_global_data_t bar;
+static double y[R];
+static size_t cycles[MAX_HARTS], cold[MAX_HARTS], bytes[MAX_HARTS];
+
+// The first row of hart cid's share, so that each gets about NNZ/nc
+// nonzeros
+static int row_split(int cid, int nc)
 {
-  double y[R];
+  if (cid == nc)
+    return R;
+  int target = (long)NNZ*cid/nc, lo = 0, hi = R;
+  while (lo < hi)
+  {
+    int mid = (lo + hi)/2;
+    if (ptr[mid] < target)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return lo;
+}
 
-#if PREALLOCATE
-  spmv(R, val, idx, x, ptr, y);
+static void spmv_part(int f, const part_t* m)
+{
+  switch (f)
+  {
+    case CSR:
+      spmv(m->r1 - m->r0, val, idx, x, ptr + m->r0, y + m->r0);
+      break;
+    case ELL:
+      SPMV_IMPL(spmv_ell)(m->ell.r, m->ell.w, m->ell.val, m->ell.off, x, y + m->r0);
+      break;
+    case SELL:
+      SPMV_IMPL(spmv_sell)(m->sell.r, m->sell.c, m->sell.cl, m->sell.val,
+                           m->sell.off, m->sell.perm, x, y);
+      break;
+  }
+}
+
+// Bytes of the hart's matrix, row metadata and y
+static size_t part_bytes(int f, const part_t* m)
+{
+  size_t r = m->r1 - m->r0, entry = sizeof(double) + sizeof(uint32_t);
+  switch (f)
+  {
+    case CSR:
+      return (ptr[m->r1] - ptr[m->r0])*entry + (r + 1)*sizeof(int) + r*sizeof(double);
+    case ELL:
+      return r*m->ell.w*entry + r*sizeof(double);
+    default:
+    {
+      size_t entries = 0;
+      for (size_t j = 0; j < m->sell.nchunks; j++)
+        entries += m->sell.cl[j]*m->sell.c;
+      return entries*entry + m->sell.nchunks*(sizeof(uint32_t) + m->sell.c*sizeof(uint32_t))
+             + r*sizeof(double);
+    }
+  }
+}
+
+static void flush_part(int f, const part_t* m)
+{
+  size_t r = m->r1 - m->r0;
+  flushCaches(y + m->r0, r*sizeof(double));
+  switch (f)
+  {
+    case CSR:
+      flushCaches(val + ptr[m->r0], (ptr[m->r1] - ptr[m->r0])*sizeof(double));
+      flushCaches(idx + ptr[m->r0], (ptr[m->r1] - ptr[m->r0])*sizeof(int));
+      flushCaches(ptr + m->r0, (r + 1)*sizeof(int));
+      break;
+    case ELL:
+      flushCaches(m->ell.val, r*m->ell.w*sizeof(double));
+      flushCaches(m->ell.off, r*m->ell.w*sizeof(uint32_t));
+      break;
+    case SELL:
+    {
+      size_t entries = 0;
+      for (size_t j = 0; j < m->sell.nchunks; j++)
+        entries += m->sell.cl[j]*m->sell.c;
+      flushCaches(m->sell.cl, m->sell.nchunks*sizeof(uint32_t));
+      flushCaches(m->sell.perm, m->sell.nchunks*m->sell.c*sizeof(uint32_t));
+      flushCaches(m->sell.val, entries*sizeof(double));
+      flushCaches(m->sell.off, entries*sizeof(uint32_t));
+      break;
+    }
+  }
+}
+
+// GFLOP/s at 1 GHz are flops per cycle
+static void print_rate(const char* what, size_t flops, size_t bytes, size_t cycles)
+{
+  size_t gflops = 1000*flops/cycles, bpc = 100*bytes/cycles;
+  printf("%s%d.%03d GFLOP/s, %d.%02d bytes/cycle", what,
+         (int)(gflops/1000), (int)(gflops%1000), (int)(bpc/100), (int)(bpc%100));
+}
+
+#ifndef VERIFY_DIGEST
+# define VERIFY_DIGEST gen_verify_digest()
 #endif
 
-  setStats(1);
-  spmv(R, val, idx, x, ptr, y);
-  setStats(0);
+void thread_entry(int cid, int nc)
+{
+  barrier_local_data_t lbar = {nc};
+  part_t m;
+  int res = 0;
+
+#if GEN_DATA
+  if (cid == 0)
+    gen_matrix();
+  barrier(&bar, &lbar);
+#endif
+
+  m.r0 = row_split(cid, nc);
+  m.r1 = row_split(cid + 1, nc);
+  to_ell(&m.ell, m.r0, m.r1);
+  to_sell(&m.sell, m.r0, m.r1);
+  setStatsSize(NNZ);
+
+  if (cid == 0)
+    printf("%d x %d, %d nonzeros on %d harts, SELL-%d-%d, rates @ 1 GHz\n", R, C, NNZ, nc,
+           (int)m.sell.c, (int)((SELL_SIGMA + m.sell.c - 1)/m.sell.c*m.sell.c));
+
+  for (int f = 0; f < NFORMATS; f++)
+  {
+    size_t nnz = ptr[m.r1] - ptr[m.r0];
+    memset(y + m.r0, 0, (m.r1 - m.r0)*sizeof(double));
+    bytes[cid] = part_bytes(f, &m);
+    barrier(&bar, &lbar);
+
+    cycles[cid] = bench_runs(format_name[f], spmv_part(f, &m), nnz, BENCH_WARMUP, );
+    cold[cid] = bench_runs(cold_name[f], spmv_part(f, &m), nnz, 0,
+                           flush_part(f, &m);
+                           if (cid == 0)
+                             flushCaches(x, sizeof(x));
+                           barrier(&bar, &lbar));
+
+    barrier(&bar, &lbar);
+
+    if (cid == 0)
+    {
+      // the aggregate rate is set by the slowest hart
+      size_t slowest = 0, slowest_cold = 0, total = C*sizeof(double);
+      for (int h = 0; h < nc; h++)
+      {
+        slowest = cycles[h] > slowest ? cycles[h] : slowest;
+        slowest_cold = cold[h] > slowest_cold ? cold[h] : slowest_cold;
+        total += bytes[h];
+      }
+      printf("%s: ", format_name[f]);
+      print_rate("", 2*NNZ, total, slowest);
+      print_rate(", cold ", 2*NNZ, total, slowest_cold);
+      printf("\n");
+
+      if (verifyDoubleDigest(R, y, VERIFY_DIGEST))
+      {
+        printf("%s: wrong result\n", format_name[f]);
+        res |= 1 << f;
+      }
+    }
+    barrier(&bar, &lbar);
+  }
 
-  return verifyDouble(R, y, verify_data);
+  if (cid == 0 && res)
+    exit(res);
+  barrier(&bar, &lbar);
+  exit(0);
 }
@@ -0,0 +1,204 @@
+// See LICENSE for license details.
+
+//**************************************************************************
+// STREAM-style memory bandwidth benchmark
+//--------------------------------------------------------------------------
+//
+// The four STREAM kernels, copy (c = a), scale (b = s*c), add (c = a+b)
+// and triad (a = b + s*c), over three arrays whose combined size sweeps
+// from STREAM_MIN to STREAM_MAX bytes, doubling each time.  The sweep
+// runs scalar on one hart and on all of them, and again with RVV kernels
+// (see vec-stream.S) when built for a vector core.  Every run reports
+// bytes/cycle, counting the bytes each kernel reads and writes, and a
+// table of them all follows at the end.  STREAM_MAX should be well past
+// the last-level cache.
+
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "util.h"
+
+// the scalar kernels stay scalar
+#pragma GCC optimize ("no-tree-vectorize")
+
+#ifndef STREAM_MIN
+# define STREAM_MIN (4 << 10)
+#endif
+#ifndef STREAM_MAX
+# define STREAM_MAX (8 << 20)
+#endif
+#define STREAM_N (STREAM_MAX/3/sizeof(double))
+#define NSIZES 16
+
+static double a[STREAM_N], b[STREAM_N], c[STREAM_N];
+static const double scalar = 3;
+
+//--------------------------------------------------------------------------
+// Kernels
+
+static void stream_copy(size_t n, const double* a, double* c)
+{
+  for (size_t i = 0; i < n; i++)
+    c[i] = a[i];
+}
+
+static void stream_scale(size_t n, double s, const double* c, double* b)
+{
+  for (size_t i = 0; i < n; i++)
+    b[i] = s*c[i];
+}
+
+static void stream_add(size_t n, const double* a, const double* b, double* c)
+{
+  for (size_t i = 0; i < n; i++)
+    c[i] = a[i] + b[i];
+}
+
+static void stream_triad(size_t n, double s, const double* b, const double* c, double* a)
+{
+  for (size_t i = 0; i < n; i++)
+    a[i] = b[i] + s*c[i];
+}
+
+#if defined(__riscv_vector)
+# define NVARIANTS 4
+void stream_copy_vec(size_t n, const double* a, double* c);
+void stream_scale_vec(size_t n, double s, const double* c, double* b);
+void stream_add_vec(size_t n, const double* a, const double* b, double* c);
+void stream_triad_vec(size_t n, double s, const double* b, const double* c, double* a);
+#else
+# define NVARIANTS 2
+#endif
+
+enum { COPY, SCALE, ADD, TRIAD, NKERNELS };
+static const char* kernel_name[NKERNELS] = {"copy", "scale", "add", "triad"};
+// bytes read and written per element
+static const int kernel_bytes[NKERNELS] = {16, 16, 24, 24};
+
+static void kernel(int k, int vec, size_t lo, size_t hi)
+{
+  size_t n = hi - lo;
+#if defined(__riscv_vector)
+  if (vec)
+  {
+    switch (k)
+    {
+      case COPY: stream_copy_vec(n, a + lo, c + lo); break;
+      case SCALE: stream_scale_vec(n, scalar, c + lo, b + lo); break;
+      case ADD: stream_add_vec(n, a + lo, b + lo, c + lo); break;
+      case TRIAD: stream_triad_vec(n, scalar, b + lo, c + lo, a + lo); break;
+    }
+    return;
+  }
+#endif
+  switch (k)
+  {
+    case COPY: stream_copy(n, a + lo, c + lo); break;
+    case SCALE: stream_scale(n, scalar, c + lo, b + lo); break;
+    case ADD: stream_add(n, a + lo, b + lo, c + lo); break;
+    case TRIAD: stream_triad(n, scalar, b + lo, c + lo, a + lo); break;
+  }
+}
+
+//--------------------------------------------------------------------------
+// Main
+
+static barrier_global_data_t bar;
+static size_t cycles[MAX_HARTS];
+// bytes/cycle in hundredths, by variant, size and kernel
+static size_t result[NVARIANTS][NSIZES][NKERNELS];
+static volatile int wrong;
+
+static void print_bpc(size_t bpc)
+{
+  printf("%4d.%02d", (int)(bpc/100), (int)(bpc%100));
+}
+
+void thread_entry(int cid, int nc)
+{
+  barrier_local_data_t lbar = {nc};
+  int nsizes = 0;
+
+  for (int v = 0; v < NVARIANTS; v++)
+  {
+    // scalar on one hart, then all harts, then the same with RVV
+    int vec = v >= 2, harts = v % 2 ? nc : 1;
+    if (v % 2 && nc == 1)
+      continue;
+    if (cid == 0)
+      printf("%s, %d harts\n", vec ? "vector" : "scalar", harts);
+
+    nsizes = 0;
+    for (size_t size = STREAM_MIN; size <= STREAM_MAX && nsizes < NSIZES; size *= 2, nsizes++)
+    {
+      size_t n = size/3/sizeof(double);
+      size_t lo = cid < harts ? n*cid/harts : n, hi = cid < harts ? n*(cid+1)/harts : n;
+
+      // wait for the last size's check of what may now be our slice
+      barrier(&bar, &lbar);
+      for (size_t i = lo; i < hi; i++)
+      {
+        a[i] = 1;
+        b[i] = 2;
+        c[i] = 0;
+      }
+
+      for (int k = 0; k < NKERNELS; k++)
+      {
+        barrier(&bar, &lbar);
+        cycles[cid] = bench_runs(kernel_name[k], kernel(k, vec, lo, hi), hi - lo,
+                                 BENCH_WARMUP, barrier(&bar, &lbar));
+        barrier(&bar, &lbar);
+
+        if (cid == 0)
+        {
+          size_t slowest = 0;
+          for (int h = 0; h < harts; h++)
+            slowest = cycles[h] > slowest ? cycles[h] : slowest;
+          size_t bpc = 100*kernel_bytes[k]*n/slowest;
+          result[v][nsizes][k] = bpc;
+          printf("%d KB %s:", (int)(size >> 10), kernel_name[k]);
+          print_bpc(bpc);
+          printf(" bytes/cycle\n");
+        }
+      }
+
+      // copy, scale, add and triad in turn leave a = 15, b = 3, c = 4
+      for (size_t i = lo; i < hi; i++)
+        if (a[i] != 15 || b[i] != 3 || c[i] != 4)
+          wrong = 1;
+    }
+  }
+
+  barrier(&bar, &lbar);
+  if (cid == 0)
+  {
+    printf("bytes/cycle  ");
+    for (int k = 0; k < NKERNELS; k++)
+      printf(" %7s", kernel_name[k]);
+    printf("\n");
+    for (int v = 0; v < NVARIANTS; v++)
+    {
+      if (v % 2 && nc == 1)
+        continue;
+      printf("%s, %d harts\n", v >= 2 ? "vector" : "scalar", v % 2 ? nc : 1);
+      for (int s = 0; s < nsizes; s++)
+      {
+        printf("%8d KB  ", (int)((size_t)STREAM_MIN << s >> 10));
+        for (int k = 0; k < NKERNELS; k++)
+        {
+          printf(" ");
+          print_bpc(result[v][s][k]);
+        }
+        printf("\n");
+      }
+    }
+  }
+
+  if (cid == 0 && wrong)
+    printf("wrong result\n");
+  // wrong is shared, so every hart exits with the same verdict, but
+  // none of them before hart 0 has finished the table
+  barrier(&bar, &lbar);
+  exit(wrong);
+}
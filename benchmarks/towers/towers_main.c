@@ -224,6 +224,7 @@ int main( int argc, char* argv[] )
   // Solve it
 
   towers_clear( &towers );
+  setStatsSize(NUM_DISCS);
   setStats(1);
   towers_solve( &towers );
   setStats(0);
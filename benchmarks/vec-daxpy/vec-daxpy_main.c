@@ -34,6 +34,7 @@ int main( int argc, char* argv[] )
 #endif
 
   // Do the daxpy
+  setStatsSize(DATA_SIZE);
   setStats(1);
   vec_daxpy(DATA_SIZE, &input0, input1_data, input2_data, results_data);
   setStats(0);
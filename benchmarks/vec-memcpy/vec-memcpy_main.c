@@ -4,7 +4,8 @@
 // Memcpy benchmark
 //--------------------------------------------------------------------------
 //
-// This benchmark tests a vectorized memcpy implementation.
+// This benchmark tests a vectorized memcpy implementation, and reports
+// the scalar memcpy from syscalls.c alongside it.
 // The input data (and reference data) should be generated using
 // the memcpy_gendata.pl perl script and dumped to a file named
 // dataset1.h.
@@ -31,7 +32,14 @@ int main( int argc, char* argv[] )
   vec_memcpy(results_data, input_data, sizeof(int) * DATA_SIZE);
 #endif
 
+  // For comparison, time the scalar memcpy from syscalls.c
+  memset(results_data, 0, sizeof(int) * DATA_SIZE);
+  stats(memcpy_scalar(results_data, input_data, sizeof(int) * DATA_SIZE), DATA_SIZE);
+  if (verify( DATA_SIZE, results_data, input_data ))
+    return 1;
+
   // Do the riscv-linux memcpy
+  memset(results_data, 0, sizeof(int) * DATA_SIZE);
   setStats(1);
   vec_memcpy(results_data, input_data, sizeof(int) * DATA_SIZE); //, DATA_SIZE * sizeof(int));
   setStats(0);
@@ -30,6 +30,7 @@ int main( int argc, char* argv[] )
 #endif
 
   // Do the sgemm
+  setStatsSize(DIM_SIZE*DIM_SIZE*DIM_SIZE);
   setStats(1);
   vec_sgemm_nn(DIM_SIZE, DIM_SIZE, DIM_SIZE, input1_data, DIM_SIZE, input2_data, DIM_SIZE, results_data, DIM_SIZE);
   setStats(0);
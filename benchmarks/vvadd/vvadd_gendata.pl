@@ -7,8 +7,8 @@
 #
 (our $usageMsg = <<'ENDMSG') =~ s/^\#//gm;
 #
-# Simple script which creates an input data set and the reference data
-# for the vvadd benchmark.
+# Simple script which creates an input data set and the digest of the
+# reference results for the vvadd benchmark.
 #
 ENDMSG
 
@@ -106,6 +106,24 @@ sub printArray
   print  "};\n\n";
 }
 
+sub printDigest
+{
+  my $arrayRef = $_[0];
+
+  # CRC-64 of the elements, one 64-bit word each, matching digest_u64()
+  # in common/util.h
+  no warnings "portable";
+  my $crc = ~0;
+  foreach my $value ( @{$arrayRef} ) {
+    $crc ^= $value & 0xffffffff;
+    for ( my $i = 0; $i < 64; $i++ ) {
+      $crc = ( $crc >> 63 ) ? ( $crc << 1 ) ^ 0x42f0e1eba9ea3693 : $crc << 1;
+    }
+  }
+
+  print sprintf( "#define VERIFY_DIGEST 0x%016xULL\n\n", $crc );
+}
+
 #--------------------------------------------------------------------------
 # Main
 #--------------------------------------------------------------------------
@@ -131,7 +149,7 @@ sub main()
   print "\n\#define DATA_SIZE ".$opts{"size"}." \n\n";
   printArray( "input1_data", \@values1 );
   printArray( "input2_data", \@values2 );
-  printArray( "verify_data", \@sum );
+  printDigest( \@sum );
 
 }
 
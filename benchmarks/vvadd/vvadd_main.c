@@ -5,16 +5,27 @@
 //--------------------------------------------------------------------------
 //
 // This benchmark uses adds to vectors and writes the results to a
-// third vector. The input data (and reference data) should be
-// generated using the vvadd_gendata.pl perl script and dumped
-// to a file named dataset1.h.
+// third vector. The input data (and the digest of the expected
+// results) should be generated using the vvadd_gendata.pl perl script
+// and dumped to a file named dataset1.h.  Alternatively, building with
+// -DDATA_SIZE=n generates n-element inputs at startup; the expected
+// digest is then recomputed on target unless -DVERIFY_DIGEST gives it.
  
 #include "util.h"
 
 //--------------------------------------------------------------------------
 // Input/Reference Data
 
+#ifdef DATA_SIZE
+#include "gendata.h"
+#define GEN_DATA 1
+#define SEED1 1
+#define SEED2 2
+int input1_data[DATA_SIZE];
+int input2_data[DATA_SIZE];
+#else
 #include "dataset1.h"
+#endif
 
 //--------------------------------------------------------------------------
 // vvadd function
@@ -31,7 +42,13 @@ void vvadd( int n, int a[], int b[], int c[] )
 
 int main( int argc, char* argv[] )
 {
+#if GEN_DATA
+  static int results_data[DATA_SIZE];
+  gen_int(input1_data, 0, DATA_SIZE, SEED1, 999);
+  gen_int(input2_data, 0, DATA_SIZE, SEED2, 999);
+#else
   int results_data[DATA_SIZE];
+#endif
 
 #if PREALLOCATE
   // If needed we preallocate everything in the caches
@@ -39,10 +56,17 @@ int main( int argc, char* argv[] )
 #endif
 
   // Do the vvadd
+  setStatsSize(DATA_SIZE);
   setStats(1);
   vvadd( DATA_SIZE, input1_data, input2_data, results_data );
   setStats(0);
 
   // Check the results
-  return verify( DATA_SIZE, results_data, verify_data );
+#ifndef VERIFY_DIGEST
+  uint64_t digest = DIGEST_INIT;
+  for (size_t i = 0; i < DATA_SIZE; i++)
+    digest = digest_u64(digest, gen_range(SEED1, i, 999) + gen_range(SEED2, i, 999));
+# define VERIFY_DIGEST digest
+#endif
+  return verifyDigest( DATA_SIZE, results_data, VERIFY_DIGEST );
 }